@@ -2,6 +2,35 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 #include "../include/graph.hpp"
+#include "../include/implicit_graph.hpp"
+#include "../include/algorithm_shortest_paths.hpp"
+#include "../include/algorithm_all_pairs_shortest_paths.hpp"
+#include "../include/algorithm_reachability.hpp"
+#include "../include/algorithm_triangles.hpp"
+#include "../include/algorithm_page_rank.hpp"
+#include "../include/algorithm_spanning_tree.hpp"
+#include "../include/algorithm_max_flow.hpp"
+#include "../include/algorithm_coloring.hpp"
+#include "../include/algorithm_topological_sort.hpp"
+#include "../include/algorithm_k_core.hpp"
+#include "../include/algorithm_centrality.hpp"
+#include "../include/algorithm_communities.hpp"
+#include "../include/algorithm_matching.hpp"
+#include "../include/algorithm_force_layout.hpp"
+#include "../include/algorithm_coarsening.hpp"
+#include "../include/memory_resources.hpp"
+#include "../include/spatial_index.hpp"
+#include "../include/attribute_columns.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <thread>
+#include <utility>
 
 
 TEST_SUITE("Basic tests")
@@ -41,3 +70,1255 @@ TEST_SUITE("Basic tests")
     }
 }
 
+
+
+TEST_SUITE("Implicit graphs")
+{
+    TEST_CASE("Grid, torus, hypercube, circulant")
+    {
+        auto grid = gravis24::newGrid2DGraph(4, 3);
+        REQUIRE(grid != nullptr);
+        CHECK(grid->getVertexCount() == 12);
+        CHECK(grid->getTargetCount(0) == 2);
+        CHECK(grid->getTargetCount(5) == 4);
+        CHECK(grid->getTargets(5).size() == 4);
+        CHECK(grid->areConnected(5, 6));
+        CHECK(grid->areConnected(5, 1));
+        CHECK(!grid->areConnected(3, 4));
+
+        auto torus = gravis24::newTorus2DGraph(4, 3);
+        REQUIRE(torus != nullptr);
+        CHECK(torus->getTargetCount(0) == 4);
+        CHECK(torus->areConnected(3, 0));
+        CHECK(torus->areConnected(0, 8));
+
+        auto cube = gravis24::newHypercubeGraph(3);
+        REQUIRE(cube != nullptr);
+        CHECK(cube->getVertexCount() == 8);
+        CHECK(cube->getTargetCount(5) == 3);
+        CHECK(cube->areConnected(5, 4));
+        CHECK(!cube->areConnected(5, 6));
+
+        int const offsets[] { 1, -1, 7 };
+        auto ring = gravis24::newCirculantGraph(7, offsets);
+        REQUIRE(ring != nullptr);
+        CHECK(ring->getTargetCount(0) == 2);
+        CHECK(ring->areConnected(0, 6));
+
+        auto complete = gravis24::newCompleteGraph(5);
+        REQUIRE(complete != nullptr);
+        CHECK(complete->getTargets(3).size() == 4);
+        CHECK(!complete->areConnected(3, 3));
+        CHECK(gravis24::newGrid3DGraph(2000, 2000, 2000) == nullptr);
+    }
+
+    TEST_CASE("3D lattices and copied neighbourhoods")
+    {
+        auto const copied = [](gravis24::ImplicitGraphView const& graph, int vertex)
+            {
+                std::vector<int> buffer(static_cast<size_t>(graph.getMaxTargetCount()));
+                buffer.resize(static_cast<size_t>(graph.copyTargets(vertex, buffer)));
+                return buffer;
+            };
+
+        // 4 x 3 x 2: шаги по осям 1, 4, 12.
+        auto grid = gravis24::newGrid3DGraph(4, 3, 2);
+        REQUIRE(grid != nullptr);
+        CHECK(grid->getVertexCount() == 24);
+        CHECK(grid->getMaxTargetCount() == 5);
+        CHECK(copied(*grid, 0) == std::vector<int>{ 1, 4, 12 });
+        CHECK(copied(*grid, 5) == std::vector<int>{ 4, 6, 1, 9, 17 });
+        CHECK(grid->getTargetCount(5) == 5);
+        CHECK(grid->areConnected(17, 5));
+        CHECK(!grid->areConnected(3, 4));
+        CHECK(!grid->areConnected(0, 5));
+
+        int small[2] {};
+        int large[5] {};
+        CHECK(grid->copyTargets(5, small) == 0);
+        CHECK(grid->copyTargets(24, large) == 0);
+
+        // 4 x 3 x 5 с замыканием: шаги 1, 4, 12.
+        auto torus = gravis24::newTorus3DGraph(4, 3, 5);
+        REQUIRE(torus != nullptr);
+        CHECK(torus->getVertexCount() == 60);
+        CHECK(copied(*torus, 0) == std::vector<int>{ 3, 1, 8, 4, 48, 12 });
+        CHECK(torus->getTargetCount(59) == 6);
+        CHECK(torus->areConnected(0, 48));
+        CHECK(torus->areConnected(59, 11));
+        CHECK(!torus->areConnected(0, 24));
+
+        // Ось длины 2: оба соседа по тору совпадают, дуга одна.
+        auto thin = gravis24::newTorus3DGraph(3, 3, 2);
+        REQUIRE(thin != nullptr);
+        CHECK(copied(*thin, 0) == std::vector<int>{ 2, 1, 6, 3, 9 });
+
+        int const offsets[] { 1, 3 };
+        auto ring = gravis24::newCirculantGraph(7, offsets);
+        REQUIRE(ring != nullptr);
+        CHECK(copied(*ring, 5) == std::vector<int>{ 6, 1, 2, 4 });
+    }
+
+    TEST_CASE("Circulant graph with more than INT_MAX / 2 vertices")
+    {
+        int const n = INT_MAX - 1;
+        int const offsets[] { 5, INT_MAX, INT_MIN };
+        auto ring = gravis24::newCirculantGraph(n, offsets);
+        REQUIRE(ring != nullptr);
+        // Сдвиги 5 и n - 5; 1 и n - 1 (INT_MAX = n + 1); 2 и n - 2 (INT_MIN = -(n + 2)).
+        CHECK(ring->getMaxTargetCount() == 6);
+        CHECK(ring->areConnected(0, 5));
+        CHECK(ring->areConnected(5, 0));
+        CHECK(ring->areConnected(0, 1));
+        CHECK(ring->areConnected(0, n - 1));
+        CHECK(ring->areConnected(n - 1, 0));
+        CHECK(ring->areConnected(0, 2));
+        CHECK(ring->areConnected(0, n - 2));
+        CHECK(!ring->areConnected(0, 3));
+    }
+}
+
+
+TEST_SUITE("Shortest paths")
+{
+    TEST_CASE("Dijkstra and delta-stepping agree")
+    {
+        auto el = gravis24::newEdgeListUnsortedVector(0, 0, 1);
+        float const weights[] { 4.f, 1.f, 2.f, 5.f, 1.f };
+        el->connect(0, 1);
+        el->connect(0, 2);
+        el->connect(2, 1);
+        el->connect(1, 3);
+        el->connect(2, 3);
+        auto w = el->getFloatAttributes(0);
+        REQUIRE(w.size() == 5);
+        std::ranges::copy(weights, w.begin());
+
+        gravis24::algorithm::Dijkstra dijkstra;
+        auto const sp = dijkstra.run(*el, 5, 0, 0);
+        REQUIRE(sp.distances.size() == 5);
+        CHECK(sp.distances[1] == 3.f);
+        CHECK(sp.distances[3] == 2.f);
+        CHECK(sp.parents[3] == 2);
+        CHECK(sp.parentArcs[3] == 4);
+        CHECK(sp.parents[4] == -1);
+
+        gravis24::algorithm::DeltaStepping deltaStepping(1.5f);
+        auto const ds = deltaStepping.run(*el, 5, 0, 0);
+        CHECK(ds.distances == sp.distances);
+        CHECK(ds.parents == sp.parents);
+
+        CHECK(dijkstra.run(*el, 5, 1, 0).distances.empty());
+    }
+
+    TEST_CASE("Delta-stepping with huge distances and an invalid delta")
+    {
+        // Частное расстояния и delta далеко за пределами uint64_t.
+        auto el = gravis24::newEdgeListUnsortedVector(0, 0, 1);
+        float const weights[] { 1e30f, 1e30f, 1.f, std::numeric_limits<float>::infinity() };
+        el->connect(0, 1);
+        el->connect(1, 2);
+        el->connect(0, 2);
+        el->connect(2, 3);
+        std::ranges::copy(weights, el->getFloatAttributes(0).begin());
+
+        gravis24::algorithm::Dijkstra dijkstra;
+        auto const sp = dijkstra.run(*el, 4, 0, 0);
+        REQUIRE(sp.distances.size() == 4);
+        for (float const delta: { 1e-30f, 0.f })
+        {
+            gravis24::algorithm::DeltaStepping deltaStepping(delta);
+            auto const ds = deltaStepping.run(*el, 4, 0, 0);
+            CHECK(ds.distances == sp.distances);
+            CHECK(ds.parents == sp.parents);
+        }
+
+        for (float const delta: { -1.f, std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN() })
+            CHECK(gravis24::algorithm::DeltaStepping(delta).run(*el, 4, 0, 0).distances.empty());
+    }
+}
+
+
+TEST_SUITE("All pairs shortest paths")
+{
+    TEST_CASE("Blocked Floyd-Warshall on a chain crossing block borders")
+    {
+        int const n = 100;
+        auto am = gravis24::newDenseAdjacencyMatrix(n);
+        for (int v = 0; v + 1 < n; ++v)
+            am->set(v, v + 1);
+
+        auto const dm = gravis24::algorithm::computeAllPairsShortestPaths(*am);
+        REQUIRE(dm.getVertexCount() == n);
+        CHECK(dm(0, n - 1) == float(n - 1));
+        CHECK(dm(10, 70) == 60.f);
+        CHECK(dm(70, 10) == std::numeric_limits<float>::infinity());
+        CHECK(dm(42, 42) == 0.f);
+    }
+
+    TEST_CASE("Weighted Floyd-Warshall takes weights from the arc list")
+    {
+        int const n = 70;
+        auto am = gravis24::newDenseAdjacencyMatrix(n);
+        auto el = gravis24::newEdgeListUnsortedVector(0, 0, 1);
+        auto const connect = [&](int source, int target, float weight)
+            {
+                auto const arc = el->connect(source, target);
+                el->getFloatAttributes(0)[arc] = weight;
+            };
+
+        // Кратные дуги 0 -> 1: берётся наименьший вес.
+        am->set(0, 1);
+        connect(0, 1, 5.f);
+        connect(0, 1, 2.f);
+        // Отрицательный вес.
+        am->set(1, 2);
+        connect(1, 2, -1.f);
+        am->set(0, 2);
+        connect(0, 2, 3.f);
+        // Дуга 2 -> 69 есть только в am: вес 1.
+        am->set(2, 69);
+        am->set(69, 3);
+        connect(69, 3, -0.5f);
+        // Дуга только в el не учитывается.
+        connect(0, 3, -100.f);
+
+        auto const dm = gravis24::algorithm::computeAllPairsShortestPaths(*am, *el, 0);
+        REQUIRE(dm.getVertexCount() == n);
+        CHECK(dm(0, 1) == 2.f);
+        CHECK(dm(0, 2) == 1.f);
+        CHECK(dm(2, 69) == 1.f);
+        CHECK(dm(0, 69) == 2.f);
+        CHECK(dm(0, 3) == 1.5f);
+        CHECK(dm(3, 0) == std::numeric_limits<float>::infinity());
+        CHECK(dm(0, 0) == 0.f);
+
+        CHECK(gravis24::algorithm::computeAllPairsShortestPaths(*am, *el, 1).empty());
+        CHECK(gravis24::algorithm::computeAllPairsShortestPaths(*am, *el, -1).empty());
+        el->getFloatAttributes(0)[0] = std::numeric_limits<float>::quiet_NaN();
+        CHECK(gravis24::algorithm::computeAllPairsShortestPaths(*am, *el, 0).empty());
+    }
+}
+
+
+TEST_SUITE("Reachability")
+{
+    TEST_CASE("Transitive closure: dense and condensation paths agree")
+    {
+        auto graph = gravis24::newGraph(6);
+        graph->connect(0, 1);
+        graph->connect(1, 2);
+        graph->connect(2, 0);
+        graph->connect(2, 3);
+        graph->connect(4, 5);
+
+        auto const scc = gravis24::algorithm::computeStronglyConnectedComponents(
+            graph->getAdjacencyListView());
+        CHECK(scc.componentCount == 4);
+        CHECK(scc.components[0] == scc.components[2]);
+        CHECK(scc.components[3] < scc.components[0]);
+
+        auto const dense  = gravis24::algorithm::computeTransitiveClosure(graph->getAdjacencyMatrixView());
+        auto const sparse = gravis24::algorithm::computeTransitiveClosure(graph->getAdjacencyListView());
+        for (int i = 0; i < 6; ++i)
+            for (int j = 0; j < 6; ++j)
+                CHECK(dense->get(i, j) == sparse->get(i, j));
+
+        CHECK(dense->get(1, 3));
+        CHECK(dense->get(1, 1));
+        CHECK(!dense->get(3, 3));
+        CHECK(!dense->get(3, 0));
+        CHECK(!dense->get(0, 4));
+    }
+}
+
+
+TEST_SUITE("Triangles")
+{
+    TEST_CASE("Triangle counts and clustering on two triangles sharing an edge")
+    {
+        auto graph = gravis24::newGraph(5);
+        graph->connect(0, 1);
+        graph->connect(1, 2);
+        graph->connect(2, 0);
+        graph->connect(1, 3);
+        graph->connect(3, 2);
+        graph->connect(3, 4);
+
+        CHECK(gravis24::algorithm::countTriangles(graph->getAdjacencyListView()) == 2);
+        CHECK(gravis24::algorithm::countTriangles(graph->getAdjacencyMatrixView()) == 2);
+
+        auto const cc = gravis24::algorithm::computeClusteringCoefficients(graph->getAdjacencyListView());
+        REQUIRE(cc.local.size() == 5);
+        CHECK(cc.triangles[1] == 2);
+        CHECK(cc.triangles[4] == 0);
+        CHECK(cc.local[0] == 1.f);
+        CHECK(cc.local[1] == doctest::Approx(2.f / 3.f));
+        CHECK(cc.local[4] == 0.f);
+    }
+
+    TEST_CASE("Triangle counts on a clique exercise the 8x8 intersection blocks")
+    {
+        // В клике K_n ориентированные окрестности длиной до n - 1 >= 8.
+        constexpr int n = 20;
+        auto graph = gravis24::newGraph(n);
+        for (int u = 0; u < n; ++u)
+            for (int v = u + 1; v < n; ++v)
+                graph->connect(v % 2 == 0? u: v, v % 2 == 0? v: u);
+
+        constexpr int64_t expected = int64_t{n} * (n - 1) * (n - 2) / 6;
+        CHECK(gravis24::algorithm::countTriangles(graph->getAdjacencyListView()) == expected);
+        CHECK(gravis24::algorithm::countTriangles(graph->getAdjacencyMatrixView()) == expected);
+
+        auto const cc = gravis24::algorithm::computeClusteringCoefficients(graph->getAdjacencyListView());
+        CHECK(cc.triangleCount == expected);
+        bool complete = true;
+        for (int v = 0; v < n; ++v)
+            complete = complete && cc.triangles[v] == (n - 1) * (n - 2) / 2 && cc.local[v] == doctest::Approx(1.f);
+        CHECK(complete);
+
+        // Без рёбер (i, i + 1): каждая вершина теряет до двух соседей, треугольники считаются перебором.
+        for (int v = 0; v + 1 < n; ++v)
+        {
+            graph->disconnect(v, v + 1);
+            graph->disconnect(v + 1, v);
+        }
+
+        int64_t bruteForce = 0;
+        for (int a = 0; a < n; ++a)
+            for (int b = a + 2; b < n; ++b)
+                for (int c = b + 2; c < n; ++c)
+                    ++bruteForce;
+        CHECK(gravis24::algorithm::countTriangles(graph->getAdjacencyListView()) == bruteForce);
+        CHECK(gravis24::algorithm::countTriangles(graph->getAdjacencyMatrixView()) == bruteForce);
+    }
+}
+
+
+TEST_SUITE("PageRank")
+{
+    TEST_CASE("PageRank on a cycle with a source vertex")
+    {
+        auto al = gravis24::newAdjacencyListVector();
+        al->resize(4, 0, 1);
+        al->connect(0, 1);
+        al->connect(1, 2);
+        al->connect(2, 0);
+        al->connect(3, 0);
+
+        auto const pr = gravis24::algorithm::computePageRank(*al, 0);
+        REQUIRE(pr.values.size() == 4);
+        CHECK(pr.converged);
+        CHECK(pr.values[3] == doctest::Approx(0.15f / 4.f));
+        CHECK(pr.values[0] > pr.values[1]);
+        CHECK(pr.values[0] + pr.values[1] + pr.values[2] + pr.values[3] == doctest::Approx(1.f));
+        CHECK(al->getVertexFloatAttributes(0)[0] == pr.values[0]);
+
+        float const onlyThree[] { 0.f, 0.f, 0.f, 2.f };
+        auto const ppr = gravis24::algorithm::computePersonalizedPageRank(*al, onlyThree);
+        REQUIRE(ppr.values.size() == 4);
+        CHECK(ppr.values[3] == doctest::Approx(0.15f));
+
+        CHECK(gravis24::algorithm::computePageRank(*al, 1).values.empty());
+    }
+}
+
+
+TEST_SUITE("Spanning forest")
+{
+    TEST_CASE("Kruskal and Boruvka build the same forest")
+    {
+        auto el = gravis24::newEdgeListUnsortedVector(0, 0, 1);
+        float const weights[] { 3.f, 1.f, 2.f, 1.f, 5.f, 4.f, 7.f };
+        el->connect(0, 1);
+        el->connect(1, 2);
+        el->connect(2, 0);
+        el->connect(2, 3);
+        el->connect(3, 3);
+        el->connect(4, 5);
+        el->connect(5, 4);
+        auto w = el->getFloatAttributes(0);
+        REQUIRE(w.size() == 7);
+        std::ranges::copy(weights, w.begin());
+
+        gravis24::algorithm::Kruskal kruskal;
+        auto const k = kruskal.run(*el, 7, 0);
+        CHECK(k.arcs == std::vector<int>{ 1, 3, 2, 5 });
+        CHECK(k.totalWeight == 8.);
+        CHECK(k.treeCount == 3);
+
+        gravis24::algorithm::Boruvka boruvka;
+        auto b = boruvka.run(*el, 7, 0);
+        std::ranges::sort(b.arcs);
+        CHECK(b.arcs == std::vector<int>{ 1, 2, 3, 5 });
+        CHECK(b.totalWeight == k.totalWeight);
+        CHECK(b.treeCount == k.treeCount);
+
+        CHECK(kruskal.run(*el, 7, 1).arcs.empty());
+    }
+}
+
+
+TEST_SUITE("Max flow")
+{
+    TEST_CASE("Push-relabel flow, cut and stored arc flows")
+    {
+        auto el = gravis24::newEdgeListUnsortedVector(0, 2, 0);
+        int const capacities[] { 3, 2, 1, 3, 2, 1 };
+        el->connect(0, 1);
+        el->connect(0, 2);
+        el->connect(1, 2);
+        el->connect(1, 3);
+        el->connect(2, 3);
+        el->connect(3, 0);
+        std::ranges::copy(capacities, el->getIntAttributes(0).begin());
+
+        auto const flow = gravis24::algorithm::computeMaxFlow(*el, 4, el->getIntAttributes(0), 0, 3);
+        CHECK(flow.value == 5.);
+        CHECK(flow.sourceSide == std::vector<int>{ 1, 1, 1, 0 });
+        REQUIRE(flow.arcFlows.size() == 6);
+        CHECK(flow.arcFlows[0] + flow.arcFlows[1] == 5);
+        CHECK(flow.arcFlows[3] + flow.arcFlows[4] == 5);
+        CHECK(flow.arcFlows[5] == 0);
+
+        CHECK(gravis24::storeArcIntAttributes(*el, 1, flow.arcFlows));
+        CHECK(el->getIntAttributes(1)[0] == flow.arcFlows[0]);
+
+        CHECK(gravis24::algorithm::computeMaxFlow(*el, 4, el->getIntAttributes(0), 0, 0).arcFlows.empty());
+    }
+
+    TEST_CASE("Float capacities over many orders of magnitude terminate")
+    {
+        // Ёмкости 10^[-8, 8) не представимы точно: суммирование оставляло в вершине избыток
+        // порядка 1e-14 без остаточных дуг, и возврат избытков не завершался.
+        std::mt19937 random(951);
+        auto el = gravis24::newEdgeListUnsortedVector(0, 0, 1);
+        for (int i = 0; i < 100; ++i)
+        {
+            auto const source = static_cast<int>(random() % 30);
+            auto const target = static_cast<int>(random() % 30);
+            auto const arc    = el->connect(source, target);
+            el->getFloatAttributes(0)[arc] = static_cast<float>(std::pow(10., random() / 4294967296. * 16 - 8));
+        }
+
+        auto const capacities = el->getFloatAttributes(0);
+        auto const flow = gravis24::algorithm::computeMaxFlow(*el, 30, capacities, 0, 29);
+        REQUIRE(flow.arcFlows.size() == 100);
+
+        double cut = 0;
+        bool withinCapacity = true;
+        auto const arcs = el->getArcs();
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            if (flow.sourceSide[arcs[i].source] && !flow.sourceSide[arcs[i].target])
+                cut += capacities[i];
+            withinCapacity = withinCapacity && flow.arcFlows[i] >= 0 && flow.arcFlows[i] <= capacities[i];
+        }
+        CHECK(flow.value > 0);
+        CHECK(flow.value == doctest::Approx(cut));
+        CHECK(withinCapacity);
+    }
+
+    TEST_CASE("Integer flows are conserved exactly")
+    {
+        // Возврат избытков в источник не отбрасывает ничего при целых ёмкостях.
+        std::mt19937 random(7);
+        for (int round = 0; round < 20; ++round)
+        {
+            auto el = gravis24::newEdgeListUnsortedVector(0, 1, 0);
+            for (int i = 0; i < 120; ++i)
+            {
+                auto const source = static_cast<int>(random() % 30);
+                auto const target = static_cast<int>(random() % 30);
+                auto const arc    = el->connect(source, target);
+                el->getIntAttributes(0)[arc] = static_cast<int>(random() % 1000);
+            }
+
+            auto const flow = gravis24::algorithm::computeMaxFlow(*el, 30, el->getIntAttributes(0), 0, 29);
+            REQUIRE(flow.arcFlows.size() == 120);
+
+            std::vector<int64_t> balance(30);
+            auto const arcs = el->getArcs();
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                balance[arcs[i].source] -= flow.arcFlows[i];
+                balance[arcs[i].target] += flow.arcFlows[i];
+            }
+
+            bool conserved = true;
+            for (int v = 1; v < 29; ++v)
+                conserved = conserved && balance[v] == 0;
+            CHECK(conserved);
+            CHECK(balance[29] == static_cast<int64_t>(flow.value));
+        }
+    }
+}
+
+
+TEST_SUITE("Coloring")
+{
+    TEST_CASE("Greedy orders and Jones-Plassmann give proper colorings")
+    {
+        // Колесо: цикл из 5 вершин и центр 5.
+        auto al = gravis24::newAdjacencyListVector(6);
+        for (int v = 0; v < 5; ++v)
+        {
+            al->connect(v, (v + 1) % 5);
+            al->connect(5, v);
+        }
+
+        auto const isProper = [&al](gravis24::algorithm::Coloring const& c)
+            {
+                if (c.colors.size() != 6)
+                    return false;
+                for (int v = 0; v < 6; ++v)
+                    for (int const u: al->getTargets(v))
+                        if (c.colors[u] == c.colors[v])
+                            return false;
+                return true;
+            };
+
+        using gravis24::algorithm::ColoringOrder;
+        for (auto const order: { ColoringOrder::Natural, ColoringOrder::LargestFirst, ColoringOrder::SmallestLast })
+        {
+            auto const c = gravis24::algorithm::GreedyColoring(order).run(*al);
+            CHECK(isProper(c));
+            CHECK(c.colorCount == 4);
+        }
+
+        auto const jp = gravis24::algorithm::JonesPlassmannColoring(7).run(*al);
+        CHECK(isProper(jp));
+        CHECK(jp.colorCount <= 6);
+        CHECK(gravis24::algorithm::JonesPlassmannColoring(7).run(*al).colors == jp.colors);
+    }
+}
+
+
+TEST_SUITE("Topological sort")
+{
+    TEST_CASE("Kahn order, wavefronts and critical path")
+    {
+        auto graph = gravis24::newGraph(5);
+        graph->connect(3, 1);
+        graph->connect(0, 1);
+        graph->connect(1, 2);
+        graph->connect(0, 4);
+        graph->connect(4, 2);
+
+        auto const& al = graph->getAdjacencyListView();
+        CHECK(gravis24::algorithm::computeInDegrees(al) == std::vector<int>{ 0, 2, 2, 0, 1 });
+        CHECK(gravis24::algorithm::sortTopologically(al) == std::vector<int>{ 0, 3, 4, 1, 2 });
+
+        auto const waves = gravis24::algorithm::computeWavefronts(al);
+        REQUIRE(waves.getWaveCount() == 3);
+        CHECK(waves.vertices == std::vector<int>{ 0, 3, 1, 4, 2 });
+        CHECK(waves.offsets == std::vector<int>{ 0, 2, 4, 5 });
+
+        auto const lp = gravis24::algorithm::computeLongestPaths(*graph, -1);
+        CHECK(lp.length == 2.f);
+        CHECK(lp.criticalPath.size() == 3);
+        CHECK(lp.distances[2] == 2.f);
+
+        graph->connect(2, 3);
+        CHECK(gravis24::algorithm::sortTopologically(graph->getAdjacencyListView()).empty());
+        CHECK(gravis24::algorithm::computeWavefronts(graph->getAdjacencyListView()).vertices.empty());
+    }
+}
+
+
+TEST_SUITE("K-cores")
+{
+    TEST_CASE("Bucket and peeling decompositions agree")
+    {
+        // K4 (0..3), к которому цепочкой 3 - 4 - 5 присоединены вершины степени 2 и 1.
+        auto al = gravis24::newAdjacencyListVector();
+        al->resize(7, 1, 0);
+        for (int u = 0; u < 4; ++u)
+            for (int v = u + 1; v < 4; ++v)
+                al->connect(u, v);
+        al->connect(3, 4);
+        al->connect(4, 5);
+        al->connect(5, 3);
+        al->connect(6, 5);
+
+        auto const bz = gravis24::algorithm::computeCoreDecomposition(*al, 0);
+        CHECK(bz.coreNumbers == std::vector<int>{ 3, 3, 3, 3, 2, 2, 1 });
+        CHECK(bz.degeneracy == 3);
+        CHECK(bz.degeneracyOrder.front() == 6);
+        CHECK(al->getVertexIntAttributes(4)[0] == 2);
+
+        auto const peeled = gravis24::algorithm::computeCoreDecompositionParallel(*al);
+        CHECK(peeled.coreNumbers == bz.coreNumbers);
+        CHECK(peeled.degeneracy == 3);
+        CHECK(peeled.degeneracyOrder == std::vector<int>{ 6, 4, 5, 0, 1, 2, 3 });
+    }
+}
+
+
+TEST_SUITE("Centrality")
+{
+    TEST_CASE("Betweenness, closeness and harmonic centrality on a path")
+    {
+        // Неориентированный путь 0 - 1 - 2 - 3 и изолированная вершина 4.
+        auto al = gravis24::newAdjacencyListVector(5);
+        for (int v = 0; v < 3; ++v)
+        {
+            al->connect(v, v + 1);
+            al->connect(v + 1, v);
+        }
+
+        auto const betweenness = gravis24::algorithm::computeBetweennessCentrality(*al);
+        CHECK(betweenness == std::vector<float>{ 0.f, 4.f, 4.f, 0.f, 0.f });
+        CHECK(gravis24::algorithm::computeApproximateBetweennessCentrality(*al, 5) == betweenness);
+        CHECK(gravis24::algorithm::computeApproximateBetweennessCentrality(*al, 2, 1).size() == 5);
+
+        auto const c = gravis24::algorithm::computeClosenessCentrality(*al);
+        REQUIRE(c.closeness.size() == 5);
+        CHECK(c.closeness[1] == doctest::Approx(0.75f * 0.75f));
+        CHECK(c.closeness[4] == 0.f);
+        CHECK(c.harmonic[0] == doctest::Approx(1.f + 1.f / 2.f + 1.f / 3.f));
+    }
+}
+
+
+TEST_SUITE("Communities")
+{
+    TEST_CASE("Label propagation and Louvain split two cliques joined by a bridge")
+    {
+        // Две клики K4 {0..3} и {4..7}, мост 3 - 4 с малым весом.
+        auto el = gravis24::newEdgeListUnsortedVector(0, 0, 1);
+        for (int base: { 0, 4 })
+            for (int u = base; u < base + 4; ++u)
+                for (int v = u + 1; v < base + 4; ++v)
+                    el->connect(u, v);
+        el->connect(3, 4);
+        auto w = el->getFloatAttributes(0);
+        std::ranges::fill(w, 1.f);
+        w.back() = 0.5f;
+
+        std::vector<int> const expected { 0, 0, 0, 0, 1, 1, 1, 1 };
+        auto const louvain = gravis24::algorithm::computeLouvain(*el, 8, 0);
+        CHECK(louvain.communities == expected);
+        CHECK(louvain.communityCount == 2);
+        // Q = 2 * (6 / 12.5 - (12.5 / 25)^2).
+        CHECK(louvain.modularity == doctest::Approx(2.f * (6.f / 12.5f - 0.25f)));
+
+        auto const propagation = gravis24::algorithm::computeLabelPropagation(*el, 8, 0);
+        CHECK(propagation.communities == expected);
+
+        w[0] = -1.f;
+        CHECK(gravis24::algorithm::computeLouvain(*el, 8, 0).communities.empty());
+        CHECK(gravis24::algorithm::computeLabelPropagation(*el, 8, 1).communities.empty());
+    }
+}
+
+
+TEST_SUITE("Matching")
+{
+    TEST_CASE("Hopcroft-Karp improves on greedy matching")
+    {
+        // Левая доля {0, 1, 2}, правая {3, 4, 5}. Жадный выбор 0 - 3 мешает паре 1 - 3,
+        // наибольшее паросочетание 0 - 4, 1 - 3, 2 - 5.
+        auto al = gravis24::newAdjacencyListVector(6);
+        al->connect(0, 3);
+        al->connect(0, 4);
+        al->connect(1, 3);
+        al->connect(4, 2);
+        al->connect(2, 5);
+
+        gravis24::algorithm::GreedyMatching greedy(gravis24::algorithm::MatchingHeuristic::Greedy);
+        auto const g = greedy.run(*al);
+        CHECK(g.mates == std::vector<int>{ 3, -1, 4, 0, 2, -1 });
+        CHECK(g.size == 2);
+
+        gravis24::algorithm::HopcroftKarp hopcroftKarp(gravis24::algorithm::MatchingHeuristic::Greedy);
+        auto const hk = hopcroftKarp.run(*al);
+        CHECK(hk.mates == std::vector<int>{ 4, 3, 5, 1, 0, 2 });
+        CHECK(hk.size == 3);
+
+        gravis24::algorithm::GreedyMatching karpSipser;
+        CHECK(karpSipser.run(*al).size == 3);
+
+        gravis24::algorithm::ParallelMatching parallel;
+        auto const p = parallel.run(*al);
+        CHECK(p.size >= 2);
+        for (int v = 0; v < 6; ++v)
+            if (p.mates[v] != -1)
+                CHECK(p.mates[p.mates[v]] == v);
+
+        al->connect(3, 4);
+        CHECK(hopcroftKarp.run(*al).mates.empty());
+    }
+}
+
+
+TEST_SUITE("Force layout")
+{
+    TEST_CASE("Force-directed layout pulls neighbours together and commits positions")
+    {
+        // Два треугольника {0, 1, 2} и {3, 4, 5}, соединённые ребром 2 - 3.
+        auto graph = gravis24::newGraph(6);
+        for (auto [s, t]: { std::pair{ 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 4, 5 }, { 5, 3 }, { 2, 3 } })
+            graph->connect(s, t);
+
+        struct PositionCounter final
+            : gravis24::EventListener
+        {
+            int count = 0;
+            void post(gravis24::Event const& event, gravis24::EventSource&) override
+            {
+                count += std::holds_alternative<gravis24::events::VertexPositionChanged>(event);
+            }
+        } counter;
+
+        gravis24::algorithm::ForceDirectedLayout layout({ .iterations = 50 });
+        layout.subscribe(counter);
+        REQUIRE(layout.run(*graph));
+        CHECK(counter.count == 50 * 6);
+
+        auto const positions = graph->getVertexPositions();
+        REQUIRE(positions.size() == 6);
+        auto const distance = [&positions](int a, int b)
+            {
+                auto const dx = positions[a].x - positions[b].x;
+                auto const dy = positions[a].y - positions[b].y;
+                auto const dz = positions[a].z - positions[b].z;
+                return std::sqrt(dx * dx + dy * dy + dz * dz);
+            };
+
+        CHECK(distance(0, 1) < distance(0, 4));
+        CHECK(distance(4, 5) < distance(1, 5));
+
+        std::vector<gravis24::XYZ> wrongSize(5);
+        CHECK(!layout.run(graph->getAdjacencyListView(), wrongSize));
+        layout.unsubscribe(counter);
+    }
+}
+
+
+TEST_SUITE("Vertex positions")
+{
+    TEST_CASE("Position arrays and the on-demand array of structures stay in sync")
+    {
+        auto graph = gravis24::newGraph(10);
+        {
+            auto changeable = graph->getVertexPositionArrays();
+            auto& arrays = changeable.getArrays();
+            REQUIRE(arrays.size() == 10);
+            CHECK(reinterpret_cast<uintptr_t>(arrays.getX().data()) % gravis24::VertexPositionArrays::alignment == 0);
+            for (int v = 0; v < 10; ++v)
+                arrays.set(v, { float(v), -float(v), 0.5f });
+        }
+
+        auto const box = std::as_const(*graph).getVertexPositionArrays().getBounds();
+        CHECK(box.low.x == 0.f);
+        CHECK(box.high.x == 9.f);
+        CHECK(box.low.y == -9.f);
+        CHECK(box.high.z == 0.5f);
+
+        std::span<gravis24::XYZ const> const xyz = std::as_const(*graph).getVertexPositions();
+        REQUIRE(xyz.size() == 10);
+        CHECK(xyz[3].x == 3.f);
+        CHECK(xyz[3].y == -3.f);
+
+        {
+            auto changeable = graph->getVertexPositions();
+            changeable.getSpan()[4] = { 1.f, 2.f, 3.f };
+        }
+
+        CHECK(std::as_const(*graph).getVertexPositionArrays().getY()[4] == 2.f);
+        graph->addVertex();
+        CHECK(std::as_const(*graph).getVertexPositions().size() == 11);
+    }
+}
+
+
+TEST_SUITE("Vertex position changes")
+{
+    TEST_CASE("Listeners receive only the changed vertex ranges")
+    {
+        gravis24::DirtyRanges ranges;
+        ranges.add(7);
+        ranges.add(2, 4);
+        ranges.add(4);
+        ranges.add(8);
+        ranges.normalize();
+        REQUIRE(ranges.getRanges().size() == 2);
+        CHECK(ranges.getRanges()[0].begin == 2);
+        CHECK(ranges.getRanges()[0].end == 5);
+        CHECK(ranges.getRanges()[1].begin == 7);
+        CHECK(ranges.getRanges()[1].end == 9);
+        CHECK(ranges.getIndexCount() == 5);
+        CHECK(ranges.contains(8));
+        CHECK(!ranges.contains(5));
+
+        struct Recorder final
+            : gravis24::VertexPositionListener
+        {
+            int calls = 0;
+            int count = 0;
+            void onVertexPositionsChange(gravis24::Graph const&, gravis24::DirtyRanges const& changed) override
+            {
+                ++calls;
+                count = changed.getIndexCount();
+            }
+        } recorder;
+
+        auto graph = gravis24::newGraph(1000);
+        graph->subscribe(recorder);
+        graph->subscribe(recorder);
+        CHECK(std::as_const(*graph).getVertexPositions().size() == 1000);
+        {
+            auto positions = graph->getVertexPositionArrays();
+            for (int v = 10; v < 20; ++v)
+                positions.set(v, { 1.f, 2.f, 3.f });
+        }
+
+        CHECK(recorder.calls == 1);
+        CHECK(recorder.count == 10);
+        CHECK(std::as_const(*graph).getVertexPositions()[15].y == 2.f);
+
+        {
+            auto positions = graph->getVertexPositions();
+            positions.set(500, { 4.f, 5.f, 6.f });
+        }
+
+        CHECK(recorder.calls == 2);
+        CHECK(recorder.count == 1);
+        CHECK(std::as_const(*graph).getVertexPositionArrays().getZ()[500] == 6.f);
+
+        graph->unsubscribe(recorder);
+        {
+            auto positions = graph->getVertexPositions();
+            positions.set(0, {});
+        }
+        CHECK(recorder.calls == 2);
+    }
+
+    TEST_CASE("Marked ranges are clamped to the vertex count")
+    {
+        struct Recorder final
+            : gravis24::VertexPositionListener
+        {
+            int calls = 0;
+            int count = 0;
+            void onVertexPositionsChange(gravis24::Graph const&, gravis24::DirtyRanges const& changed) override
+            {
+                ++calls;
+                count = changed.getIndexCount();
+            }
+        } recorder;
+
+        auto graph = gravis24::newGraph(4);
+        gravis24::SpatialIndex index;
+        index.build(*graph);
+        graph->subscribe(recorder);
+        graph->subscribe(index);
+        {
+            auto positions = graph->getVertexPositions();
+            positions.markChanged(0, 1000);
+        }
+        CHECK(recorder.calls == 1);
+        CHECK(recorder.count == 4);
+
+        {
+            auto positions = graph->getVertexPositionArrays();
+            positions.markChanged(-10, 2);
+        }
+        CHECK(recorder.calls == 2);
+        CHECK(recorder.count == 2);
+
+        // Пустые и целиком лежащие вне графа полуинтервалы ничего не отмечают.
+        {
+            auto positions = graph->getVertexPositions();
+            positions.markChanged(3, 3);
+            positions.markChanged(100, 1000);
+        }
+        {
+            auto positions = graph->getVertexPositionArrays();
+            positions.markChanged(2, 1);
+            positions.markChanged(-5, -1);
+        }
+        CHECK(recorder.calls == 2);
+
+        gravis24::DirtyRanges outside;
+        outside.add(2, 1000);
+        index.refit(std::as_const(*graph).getVertexPositionArrays(), outside);
+        CHECK(index.findNearestVertex({ 0.f, 0.f, 0.f }) >= 0);
+        graph->unsubscribe(index);
+        graph->unsubscribe(recorder);
+    }
+}
+
+
+TEST_SUITE("Spatial index")
+{
+    TEST_CASE("Picking and range queries follow vertex positions")
+    {
+        // Решётка 10 x 10 x 10 с шагом 1, дуги вдоль оси x.
+        auto graph = gravis24::newGraph(1000);
+        {
+            auto positions = graph->getVertexPositionArrays();
+            for (int v = 0; v < 1000; ++v)
+                positions.set(v, { float(v % 10), float(v / 10 % 10), float(v / 100) });
+        }
+
+        for (int v = 0; v < 1000; ++v)
+            if (v % 10 != 9)
+                graph->connect(v, v + 1);
+
+        gravis24::SpatialIndex index;
+        index.build(*graph);
+        graph->subscribe(index);
+
+        CHECK(index.findNearestVertex({ 3.2f, 4.9f, 7.1f }) == 753);
+        CHECK(index.findNearestVertex({ 3.2f, 4.9f, 7.1f }, 0.1f) == -1);
+        CHECK(index.findNearestVertex({ -5.f, 0.f, 0.f }) == 0);
+
+        auto inBox = index.findVerticesInBox({ { 1.5f, 1.5f, 1.5f }, { 3.f, 3.f, 3.f } });
+        std::ranges::sort(inBox);
+        CHECK(inBox == std::vector<int>{ 222, 223, 232, 233, 322, 323, 332, 333 });
+        CHECK(index.findVerticesInSphere({ 5.f, 5.f, 5.f }, 1.f).size() == 7);
+
+        auto const arc = index.findNearestArc({ 4.5f, 2.1f, 6.f });
+        auto const arcs = graph->getEdgeListView().getArcs();
+        REQUIRE(arc >= 0);
+        CHECK(arcs[arc].source == 624);
+        CHECK(arcs[arc].target == 625);
+
+        // Перемещение вершины обновляет индекс через подписку.
+        {
+            auto positions = graph->getVertexPositionArrays();
+            positions.set(999, { 20.f, 20.f, 20.f });
+        }
+        CHECK(index.findNearestVertex({ 19.f, 19.f, 19.f }) == 999);
+        CHECK(index.findNearestVertex({ 9.f, 9.f, 8.8f }) == 899);
+        CHECK(index.findNearestArc({ 15.f, 15.f, 15.f }) >= 0);
+        CHECK(arcs[index.findNearestArc({ 15.f, 15.f, 15.f })].target == 999);
+
+        graph->unsubscribe(index);
+    }
+}
+
+
+TEST_SUITE("Graph coarsening")
+{
+    TEST_CASE("Coarse levels keep vertex mass, centroid and arc counts")
+    {
+        // Цикл из 64 вершин на оси x.
+        constexpr int n = 64;
+        auto graph = gravis24::newGraph(n);
+        {
+            auto positions = graph->getVertexPositionArrays();
+            for (int v = 0; v < n; ++v)
+                positions.set(v, { float(v), 0.f, 0.f });
+        }
+
+        for (int v = 0; v < n; ++v)
+            graph->connect(v, (v + 1) % n);
+
+        gravis24::algorithm::CoarseningOptions options;
+        options.minVertexCount = 4;
+        auto const hierarchy = gravis24::algorithm::computeCoarsening(*graph, options);
+        REQUIRE(!hierarchy.levels.empty());
+
+        int fineCount = n;
+        for (auto const& level: hierarchy.levels)
+        {
+            auto const coarseCount = level.graph->getVertexCount();
+            CHECK(coarseCount <= fineCount / 2 + 1);
+            REQUIRE(level.parents.size() == size_t(fineCount));
+            REQUIRE(level.childOffsets.size() == size_t(coarseCount) + 1);
+            for (int v = 0; v < coarseCount; ++v)
+                for (int i = level.childOffsets[v]; i < level.childOffsets[v + 1]; ++i)
+                    CHECK(level.parents[level.children[i]] == v);
+
+            int    mass = 0;
+            double x    = 0.;
+            auto const& positions = std::as_const(*level.graph).getVertexPositionArrays();
+            for (int v = 0; v < coarseCount; ++v)
+            {
+                mass += level.vertexWeights[v];
+                x    += level.vertexWeights[v] * positions.getX()[v];
+            }
+            CHECK(mass == n);
+            CHECK(x / n == doctest::Approx(31.5));
+
+            auto const& el = level.graph->getEdgeListView();
+            for (auto const [source, target]: el.getArcs())
+                CHECK(source < target);
+            for (int count: el.getIntAttributes(gravis24::algorithm::CoarseLevel::arcCountAttribute))
+                CHECK(count >= 1);
+
+            // Список смежности уровня (нужен укладке и срезам) несёт те же атрибуты дуг.
+            using gravis24::algorithm::CoarseLevel;
+            auto const& al = std::as_const(*level.graph).getAdjacencyListView();
+            REQUIRE(al.getArcIntAttributeCount() == 1);
+            REQUIRE(al.getArcFloatAttributeCount() == 1);
+            auto const arcs = el.getArcs();
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                auto const arc = al.getArc(arcs[i].source, arcs[i].target);
+                REQUIRE(arc);
+                CHECK(arc->getIntAttributes()[CoarseLevel::arcCountAttribute] == el.getIntAttributes(CoarseLevel::arcCountAttribute)[i]);
+                CHECK(arc->getFloatAttributes()[CoarseLevel::arcWeightAttribute] == el.getFloatAttributes(CoarseLevel::arcWeightAttribute)[i]);
+            }
+
+            fineCount = coarseCount;
+        }
+
+        CHECK(fineCount <= 4);
+
+        options.weightAttribute = 0;
+        CHECK(gravis24::algorithm::computeCoarsening(*graph, options).levels.empty());
+    }
+}
+
+
+TEST_SUITE("Graph snapshots")
+{
+    TEST_CASE("Snapshots keep their version while the graph changes")
+    {
+        auto graph = gravis24::newGraph(100);
+        for (int v = 0; v + 1 < 100; ++v)
+            graph->connect(v, v + 1);
+        CHECK(graph->getAdjacencyListView().getTargets(0).size() == 1);
+        {
+            auto positions = graph->getVertexPositionArrays();
+            positions.set(5, { 1.f, 2.f, 3.f });
+        }
+
+        auto const snapshot = graph->snapshot();
+        CHECK(snapshot->getVersion() == graph->getVersion());
+        CHECK(snapshot->getArcCount() == 99);
+
+        // Читатели работают со срезом, пока граф изменяется.
+        int pathLength = 0;
+        std::thread reader([&snapshot, &pathLength]
+            {
+                auto const& al = snapshot->getAdjacencyListView();
+                for (int v = 0; al.getTargets(v).size() == 1; v = al.getTargets(v)[0])
+                    ++pathLength;
+                (void)snapshot->getEdgeListView();
+            });
+        for (int v = 0; v < 100; ++v)
+            graph->connect(v, (v + 7) % 100);
+        graph->disconnect(0, 1);
+        graph->addVertex(10);
+        reader.join();
+
+        CHECK(pathLength == 99);
+        CHECK(graph->getVersion() > snapshot->getVersion());
+        CHECK(graph->getArcCount() == 198);
+        CHECK(!graph->areConnected(0, 1));
+        CHECK(snapshot->getVertexCount() == 100);
+        CHECK(snapshot->getEdgeListView().getArcs().size() == 99);
+        CHECK(snapshot->getAdjacencyMatrixView().getRow(0).getBit(1));
+
+        {
+            auto positions = graph->getVertexPositionArrays();
+            positions.set(5, { 4.f, 5.f, 6.f });
+        }
+        CHECK(snapshot->getVertexPositionArrays().get(5).x == 1.f);
+        CHECK(std::as_const(*graph).getVertexPositionArrays().get(5).x == 4.f);
+        CHECK(snapshot->getVertexPositionArrays().size() == 100);
+    }
+}
+
+
+TEST_SUITE("Concurrent views")
+{
+    TEST_CASE("Views are built once under concurrent reads and can be prefetched")
+    {
+        auto graph = gravis24::newGraph(500);
+        for (int v = 0; v + 1 < 500; ++v)
+            graph->connect(v, v + 1);
+
+        gravis24::Graph const& reader = *graph;
+        gravis24::AdjacencyListView const* seen[4] {};
+        {
+            std::vector<std::thread> readers;
+            for (int i = 0; i < 4; ++i)
+                readers.emplace_back([&reader, &seen, i] { seen[i] = &reader.getAdjacencyListView(); });
+            for (auto& thread: readers)
+                thread.join();
+        }
+        for (auto const* view: seen)
+            CHECK(view == seen[0]);
+        CHECK(reader.areConnected(10, 11));
+
+        graph->removeAdjacencyList();
+        auto ready = graph->prefetchViews(gravis24::GraphViews::AdjacencyList | gravis24::GraphViews::AdjacencyMatrix);
+        CHECK(reader.getEdgeListView().getArcs().size() == 499);
+        ready.wait();
+        CHECK(graph->hasAdjacencyListView());
+        CHECK(graph->hasAdjacencyMatrixView());
+        CHECK(reader.getAdjacencyMatrixView().getRow(7).getBit(8));
+        CHECK(reader.getAdjacencyListView().getTargets(498).size() == 1);
+    }
+}
+
+
+TEST_SUITE("Memory resources")
+{
+    TEST_CASE("Graph containers allocate from an arena and from huge pages")
+    {
+        gravis24::MonotonicArena arena(4096);
+        {
+            auto al = gravis24::newAdjacencyListVector(100, &arena);
+            al->resize(100, 1, 0);
+            for (int v = 0; v < 100; ++v)
+            {
+                al->connect(v, (v + 1) % 100);
+                al->getVertexIntAttributes(v)[0] = v;
+            }
+            CHECK(al->areConnected(99, 0));
+            CHECK(al->getVertexIntAttributes(42)[0] == 42);
+
+            auto el = gravis24::newEdgeListUnsortedVector(0, 1, 0, &arena);
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto const arc = el->connect(i, i + 1);
+                el->getIntAttributes(0)[arc] = i;
+            }
+            CHECK(el->getIntAttributes(0)[999] == 999);
+        }
+
+        CHECK(arena.getAllocatedBytes() > 0);
+        CHECK(arena.getReservedBytes() >= arena.getAllocatedBytes());
+        arena.release();
+        CHECK(arena.getReservedBytes() == 0);
+
+        gravis24::HugePageResource hugePages;
+        auto am = gravis24::newDenseAdjacencyMatrix(5000, &hugePages);
+        am->set(4999, 0);
+        CHECK(am->getRow(4999).getBit(0));
+        CHECK(!am->getRow(0).getBit(4999));
+    }
+}
+
+
+TEST_SUITE("Small-buffer adjacency")
+{
+    TEST_CASE("Low- and high-degree vertices keep their targets across growth")
+    {
+        gravis24::MonotonicArena arena;
+        for (auto* resource: { std::pmr::get_default_resource(), static_cast<std::pmr::memory_resource*>(&arena) })
+        {
+            auto al = gravis24::newAdjacencyListVector(2, resource);
+            al->resize(2, 1, 1);
+            for (int t = 0; t < 3; ++t)
+                al->connect(0, t + 10);
+            for (int t = 0; t < 200; ++t)
+                al->connect(1, t + 10);
+            al->getVertexIntAttributes(1)[0]   = 7;
+            al->getVertexFloatAttributes(0)[0] = 0.5f;
+
+            // Перемещение вершин при росте вектора вершин.
+            for (int v = 0; v < 100; ++v)
+                al->addVertex();
+
+            REQUIRE(al->getTargetCount(0) == 3);
+            REQUIRE(al->getTargetCount(1) == 200);
+            CHECK(al->getTargets(0)[2] == 12);
+            bool ordered = true;
+            for (int t = 0; t < 200; ++t)
+                ordered = ordered && al->getTargets(1)[t] == t + 10;
+            CHECK(ordered);
+            CHECK(al->areConnected(1, 209));
+            CHECK(!al->areConnected(0, 13));
+            CHECK(al->getVertexIntAttributes(1)[0] == 7);
+            CHECK(al->getVertexFloatAttributes(0)[0] == 0.5f);
+            CHECK(al->getVertexIntAttributes(101).size() == 1);
+
+            auto const arc = static_cast<gravis24::AdjacencyListView const&>(*al).getArc(1, 150);
+            REQUIRE(arc);
+            CHECK(arc->target() == 150);
+            CHECK(arc->getIntAttributes().empty());
+            CHECK(!al->getArc(0, 150));
+        }
+    }
+}
+
+
+TEST_SUITE("Hub neighbour index")
+{
+    TEST_CASE("Arc lookup on a high-degree vertex")
+    {
+        auto al = gravis24::newAdjacencyListVector(1);
+        // Цели с общим шагом и в перемешанном порядке.
+        for (int i = 0; i < 5000; ++i)
+            al->connect(0, (i * 7919 % 5000) * 1024);
+
+        REQUIRE(al->getTargetCount(0) == 5000);
+        bool found = true, absent = true;
+        for (int i = 0; i < 5000; ++i)
+        {
+            found  = found  && al->areConnected(0, i * 1024);
+            absent = absent && !al->areConnected(0, i * 1024 + 1);
+        }
+        CHECK(found);
+        CHECK(absent);
+        CHECK(!al->areConnected(0, -1024));
+
+        auto const arc = static_cast<gravis24::AdjacencyListView const&>(*al).getArc(0, 4096);
+        REQUIRE(arc);
+        CHECK(arc->target() == 4096);
+        CHECK(al->getTargets(0)[1] == 2919 * 1024);
+    }
+}
+
+
+TEST_SUITE("Adjacency list mutation")
+{
+    TEST_CASE("Duplicates are rejected and disconnect removes arcs")
+    {
+        auto al = gravis24::newAdjacencyListVector(3);
+        al->reserveArcs(0, 100);
+        CHECK(al->connect(0, 1));
+        CHECK(al->connect(0, 2));
+        CHECK(al->connect(0, 3));
+        CHECK(!al->connect(0, 2));
+        CHECK(al->getTargetCount(0) == 3);
+
+        CHECK(al->disconnect(0, 1));
+        CHECK(!al->disconnect(0, 1));
+        CHECK(!al->disconnect(7, 1));
+        REQUIRE(al->getTargetCount(0) == 2);
+        CHECK(al->getTargets(0)[0] == 3);
+        CHECK(!al->areConnected(0, 1));
+        CHECK(al->connect(0, 1));
+
+        auto graph = gravis24::newGraph();
+        graph->getAdjacencyListView();
+        CHECK(graph->connect(0, 1));
+        CHECK(!graph->connect(0, 1));
+        CHECK(graph->disconnect(0, 1));
+        CHECK(!graph->areConnected(0, 1));
+        CHECK(graph->getArcCount() == 0);
+    }
+
+    TEST_CASE("Hub index stays consistent under insertions and removals")
+    {
+        auto al = gravis24::newAdjacencyListVector(1);
+        std::set<int> expected;
+        uint64_t state = 12345;
+        for (int step = 0; step < 20000; ++step)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            auto const target = static_cast<int>(state >> 40) % 3000 * 64;
+            if ((state >> 20) % 3 == 0)
+                CHECK(al->disconnect(0, target) == (expected.erase(target) == 1));
+            else
+                CHECK(al->connect(0, target) == expected.insert(target).second);
+        }
+
+        REQUIRE(al->getTargetCount(0) == static_cast<int>(expected.size()));
+        auto const targets = al->getTargets(0);
+        CHECK(std::set<int>(targets.begin(), targets.end()) == expected);
+        bool consistent = true;
+        for (int t = 0; t < 3000; ++t)
+            consistent = consistent && al->areConnected(0, t * 64) == expected.contains(t * 64);
+        CHECK(consistent);
+    }
+}
@@ -4,6 +4,7 @@
 
 #include <span>
 #include <memory>
+#include <memory_resource>
 #include <utility>
 
 namespace gravis24
@@ -80,6 +81,11 @@ namespace gravis24
                 int newVertexFloatAttributeCount = 0
             ) = 0;
 
+        /// @brief Задать число целочисленных атрибутов дуг (у новых атрибутов значение 0).
+        virtual void resizeArcIntAttributes(int attributeCount) = 0;
+        /// @brief Задать число атрибутов дуг с плавающей точкой.
+        virtual void resizeArcFloatAttributes(int attributeCount) = 0;
+
         /// @brief  Добавить новую вершину (получает наибольший индекс).
         /// @return индекс добавленной вершины
         virtual auto addVertex() -> int = 0;
@@ -87,15 +93,21 @@ namespace gravis24
         /// @brief        Добавить target в окрестность source.
         /// @param source исходная вершина дуги
         /// @param target целевая вершина дуги
-        /// @return       true, если дуга была добавлена, false иначе
+        /// @return       true, если дуга была добавлена, false иначе (дуга уже есть)
         virtual bool connect(int source, int target) = 0;
 
         /// @brief        Удалить target из окрестности source.
+        ///               Порядок остальных целей source может измениться.
         /// @param source исходная вершина дуги
         /// @param target целевая вершина дуги
         /// @return       true, если дуга была удалена, false иначе
         virtual bool disconnect(int source, int target) = 0;
 
+        /// @brief          Подготовить место под capacity дуг из vertex, чтобы connect не перераспределял память.
+        /// @param vertex   исходная вершина дуг; если её нет, ничего не делает
+        /// @param capacity ожидаемое число дуг
+        virtual void reserveArcs(int vertex, int capacity) = 0;
+
         [[nodiscard]] virtual auto getVertexIntAttributes(int vertex) noexcept
             -> std::span<int> = 0;
 
@@ -124,6 +136,11 @@ namespace gravis24
     [[nodiscard]] auto newAdjacencyListVector(int vertexCount = 0)
         -> std::unique_ptr<EditableAdjacencyList>;
 
+    /// @brief          То же, все массивы берут память у resource (см. memory_resources.hpp).
+    /// @param resource должен жить дольше списка
+    [[nodiscard]] auto newAdjacencyListVector(int vertexCount, std::pmr::memory_resource* resource)
+        -> std::unique_ptr<EditableAdjacencyList>;
+
 }
 
 #endif//GRAVIS24_ADJACENCY_LIST_HPP
@@ -0,0 +1,100 @@
+/// @file algorithm_all_pairs_shortest_paths.hpp
+/// @brief Кратчайшие пути между всеми парами вершин (блочный алгоритм Флойда -- Уоршелла).
+///
+/// Рассчитан на плотные графы (до десятков тысяч вершин): матрица расстояний
+/// обрабатывается блоками 64 x 64, помещающимися в кэш L1/L2, независимые блоки
+/// каждой фазы обрабатываются параллельно.
+#ifndef GRAVIS24_ALGORITHM_ALL_PAIRS_SHORTEST_PATHS_HPP
+#define GRAVIS24_ALGORITHM_ALL_PAIRS_SHORTEST_PATHS_HPP
+
+#include "graph.hpp"
+
+#include <span>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Квадратная матрица расстояний; длина строки в памяти (stride) дополнена
+    /// до кратной размеру блока, дополнительные элементы равны +бесконечности.
+    class DistanceMatrix
+    {
+    public:
+        DistanceMatrix() noexcept = default;
+
+        /// @brief Матрица vertexCount x vertexCount: 0 на диагонали, +бесконечность вне её.
+        explicit DistanceMatrix(int vertexCount);
+
+        [[nodiscard]] auto getVertexCount() const noexcept
+            -> int
+        {
+            return _vertexCount;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _vertexCount == 0;
+        }
+
+        /// @brief Расстояние от source до target (UB при неверных индексах).
+        [[nodiscard]] auto operator()(int source, int target) const noexcept
+            -> float
+        {
+            return _data[source * _stride + target];
+        }
+
+        [[nodiscard]] auto operator()(int source, int target) noexcept
+            -> float&
+        {
+            return _data[source * _stride + target];
+        }
+
+        /// @brief Расстояния от source до всех вершин (UB при неверном индексе).
+        [[nodiscard]] auto getRow(int source) const noexcept
+            -> std::span<float const>
+        {
+            return std::span<float const>(_data).subspan(source * _stride, _vertexCount);
+        }
+
+        [[nodiscard]] auto getStride() const noexcept
+            -> size_t
+        {
+            return _stride;
+        }
+
+        [[nodiscard]] auto data() noexcept
+            -> float*
+        {
+            return _data.data();
+        }
+
+    private:
+        int                _vertexCount {};
+        size_t             _stride      {};
+        std::vector<float> _data;
+    };
+
+
+    /// @brief Все веса дуг равны 1 (расстояние -- число дуг).
+    [[nodiscard]] auto computeAllPairsShortestPaths(DenseAdjacencyMatrixView const& am)
+        -> DistanceMatrix;
+
+    /// @brief                 Дуги берутся из am, веса -- из столбца weightAttribute списка дуг el
+    ///                        (при кратных дугах берётся наименьший вес, дуги am без пары в el имеют вес 1).
+    ///                        Допускаются отрицательные веса; отрицательный цикл проявляется
+    ///                        отрицательным значением на диагонали.
+    /// @return                пустую матрицу, если столбца нет или среди весов есть NaN
+    [[nodiscard]] auto computeAllPairsShortestPaths(
+            DenseAdjacencyMatrixView const& am,
+            EdgeListView const&             el,
+            int                             weightAttribute
+        ) -> DistanceMatrix;
+
+    /// @param weightAttribute номер столбца float списка дуг; -1 -- все веса равны 1
+    [[nodiscard]] auto computeAllPairsShortestPaths(Graph const& graph, int weightAttribute)
+        -> DistanceMatrix;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_ALL_PAIRS_SHORTEST_PATHS_HPP
@@ -0,0 +1,52 @@
+/// @file algorithm_centrality.hpp
+/// @brief Центральности, основанные на кратчайших путях (без весов, по направлению дуг):
+///        посредничество (betweenness), близость (closeness) и гармоническая.
+///
+/// Все функции выполняют обход в ширину из каждой вершины-источника (или из выборки),
+/// источники распределяются между потоками. Результаты -- массивы float по вершинам,
+/// их можно записать в атрибуты вершин функцией storeVertexFloatAttributes (attribute_columns.hpp).
+#ifndef GRAVIS24_ALGORITHM_CENTRALITY_HPP
+#define GRAVIS24_ALGORITHM_CENTRALITY_HPP
+
+#include "adjacency_list.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct ClosenessCentrality
+    {
+        /// Близость с поправкой Вассермана -- Фауста для недостижимых вершин:
+        /// (r / (n - 1)) * (r / сумма расстояний), где r -- число вершин, достижимых из v.
+        std::vector<float> closeness;
+        /// Сумма 1 / d(v, u) по достижимым вершинам u != v.
+        std::vector<float> harmonic;
+    };
+
+
+    /// @brief  Алгоритм Брандеса: для каждого источника -- обход в ширину с подсчётом числа
+    ///         кратчайших путей, затем накопление зависимостей в обратном порядке обхода.
+    ///         Каждый поток накапливает значения в своём буфере, буферы суммируются в конце.
+    /// @return посредничество каждой вершины (число пар источник -- цель, без нормировки)
+    [[nodiscard]] auto computeBetweennessCentrality(AdjacencyListView const& al)
+        -> std::vector<float>;
+
+    /// @brief             Приближённое посредничество по случайной выборке источников
+    ///                    (без повторений), умноженное на V / sampleCount.
+    /// @param sampleCount число источников; не меньше числа вершин -- точный расчёт
+    [[nodiscard]] auto computeApproximateBetweennessCentrality(
+            AdjacencyListView const& al,
+            int                      sampleCount,
+            uint64_t                 seed = 0
+        ) -> std::vector<float>;
+
+    /// @brief Близость и гармоническая центральность: расстояния от v до остальных вершин.
+    [[nodiscard]] auto computeClosenessCentrality(AdjacencyListView const& al)
+        -> ClosenessCentrality;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_CENTRALITY_HPP
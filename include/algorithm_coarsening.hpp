@@ -0,0 +1,84 @@
+/// @file algorithm_coarsening.hpp
+/// @brief Многоуровневое огрубление графа для отображения очень больших графов (уровни детализации).
+///
+/// Граф рассматривается как неориентированный взвешенный: веса берутся из столбца float
+/// (EdgeListView::getFloatAttributes), -1 -- все веса равны 1; кратные дуги складываются, петли
+/// не учитываются. Уровень строится из предыдущего: параллельное паросочетание тяжёлых рёбер
+/// ("рукопожатия", как ParallelMatching), затем вершины, оставшиеся без пары, присоединяются
+/// к кластеру самого тяжёлого соседа с парой, и кластеры сжимаются в вершины.
+///
+/// Каждый уровень -- отдельный Graph: координата вершины -- центр масс её кластера
+/// (масса -- число исходных вершин), дуги (source < target) несут атрибуты
+/// int 0 -- число исходных дуг и float 0 -- их суммарный вес. Визуализатор рисует грубый уровень
+/// и при приближении раскрывает вершины по спискам children.
+#ifndef GRAVIS24_ALGORITHM_COARSENING_HPP
+#define GRAVIS24_ALGORITHM_COARSENING_HPP
+
+#include "graph.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct CoarseningOptions
+    {
+        /// Уровни строятся, пока в последнем больше minVertexCount вершин.
+        int      minVertexCount  = 1000;
+        /// Предельное число уровней.
+        int      maxLevels       = 32;
+        /// Уровень, сохранивший больше этой доли вершин предыдущего, отбрасывается и огрубление заканчивается.
+        float    maxShrinkRatio  = 0.95f;
+        /// Номер столбца float с весами дуг исходного графа; -1 -- все веса равны 1.
+        int      weightAttribute = -1;
+        /// Для разрешения равенства весов при выборе пары.
+        uint64_t seed            = 0;
+    };
+
+
+    struct CoarseLevel
+    {
+        /// Номера атрибутов дуг graph.
+        static constexpr int arcCountAttribute  = 0;
+        static constexpr int arcWeightAttribute = 0;
+
+        std::unique_ptr<Graph> graph;
+        /// Вершина этого уровня для каждой вершины предыдущего (для первого уровня -- исходного графа).
+        std::vector<int>       parents;
+        /// Вершины предыдущего уровня, сжатые в вершину v: children[childOffsets[v] .. childOffsets[v + 1]).
+        std::vector<int>       childOffsets;
+        std::vector<int>       children;
+        /// Число исходных вершин в каждой вершине уровня.
+        std::vector<int>       vertexWeights;
+    };
+
+
+    /// Если огрубление не смогло выполниться (нет столбца весов, отрицательный вес или NaN),
+    /// levels пуст; пуст он и для графа не больше minVertexCount вершин.
+    struct CoarseningHierarchy
+    {
+        /// От мелкого к грубому: levels[0] -- первое огрубление исходного графа.
+        std::vector<CoarseLevel> levels;
+    };
+
+
+    /// @brief           Построить уровни огрубления.
+    /// @param el        список дуг исходного графа
+    /// @param positions координаты вершин; их число -- количество вершин графа
+    [[nodiscard]] auto computeCoarsening(
+            EdgeListView const&         el,
+            VertexPositionArrays const& positions,
+            CoarseningOptions const&    options = {}
+        ) -> CoarseningHierarchy;
+
+    [[nodiscard]] auto computeCoarsening(
+            Graph const&             graph,
+            CoarseningOptions const& options = {}
+        ) -> CoarseningHierarchy;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_COARSENING_HPP
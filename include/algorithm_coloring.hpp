@@ -0,0 +1,101 @@
+/// @file algorithm_coloring.hpp
+/// @brief Раскраска вершин: жадная в заданном порядке и параллельная Джонса -- Плассмана.
+///
+/// Граф рассматривается как неориентированный: смежные (в любом направлении) вершины
+/// получают разные цвета, петли не учитываются. Цвета -- номера 0, 1, 2, ...;
+/// их можно записать в целочисленный атрибут вершин функцией storeVertexIntAttributes
+/// (attribute_columns.hpp), а вершины одного цвета -- обрабатывать параллельно без конфликтов.
+///
+/// События (если есть подписчики):
+/// VertexColorChanged -- вершине назначен цвет (цвет палитры getPaletteColor).
+#ifndef GRAVIS24_ALGORITHM_COLORING_HPP
+#define GRAVIS24_ALGORITHM_COLORING_HPP
+
+#include "event_broadcaster.hpp"
+#include "graph.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct Coloring
+    {
+        /// Цвет каждой вершины.
+        std::vector<int> colors;
+        /// Число использованных цветов.
+        int              colorCount {};
+    };
+
+
+    /// Порядок, в котором жадный алгоритм назначает цвета.
+    enum class ColoringOrder
+    {
+        /// По возрастанию номеров вершин.
+        Natural,
+        /// По убыванию степени.
+        LargestFirst,
+        /// Обратный порядку удаления вершин наименьшей степени (вырожденности):
+        /// не более (вырожденность + 1) цветов.
+        SmallestLast
+    };
+
+
+    /// Каждая вершина по очереди получает наименьший цвет, не занятый её уже раскрашенными соседями.
+    class GreedyColoring
+        : public EventBroadcaster
+    {
+    public:
+        explicit GreedyColoring(ColoringOrder order = ColoringOrder::SmallestLast) noexcept
+            : _order(order)
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto run(AdjacencyListView const& al)
+            -> Coloring;
+
+        [[nodiscard]] auto run(Graph const& graph)
+            -> Coloring;
+
+    private:
+        ColoringOrder _order;
+    };
+
+
+    /// Алгоритм Джонса -- Плассмана: вершинам назначаются случайные приоритеты,
+    /// вершина раскрашивается (жадно), как только раскрашены все соседи с большим приоритетом.
+    /// Раунды обрабатывают готовые вершины параллельно; у каждой вершины хранится счётчик
+    /// ещё не раскрашенных старших соседей, поэтому общая работа O(V + E).
+    /// Результат зависит только от seed, но не от числа потоков.
+    class JonesPlassmannColoring
+        : public EventBroadcaster
+    {
+    public:
+        explicit JonesPlassmannColoring(uint64_t seed = 0) noexcept
+            : _seed(seed)
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto run(AdjacencyListView const& al)
+            -> Coloring;
+
+        [[nodiscard]] auto run(Graph const& graph)
+            -> Coloring;
+
+    private:
+        uint64_t _seed;
+    };
+
+
+    /// @brief Цвет палитры для номера цвета: оттенки, разнесённые по золотому сечению,
+    ///        так что соседние номера хорошо различимы.
+    [[nodiscard]] auto getPaletteColor(int color) noexcept
+        -> events::RGBA;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_COLORING_HPP
@@ -0,0 +1,87 @@
+/// @file algorithm_communities.hpp
+/// @brief Выделение сообществ: распространение меток и метод Лувена (модулярность).
+///
+/// Граф строится по списку дуг и рассматривается как неориентированный взвешенный:
+/// веса берутся из столбца float (EdgeListView::getFloatAttributes), -1 -- все веса равны 1;
+/// кратные дуги складываются. Номера сообществ 0, 1, ... можно записать в целочисленный
+/// атрибут вершин (storeVertexIntAttributes) и раскрасить (getPaletteColor, algorithm_coloring.hpp).
+///
+/// Вершины обрабатываются параллельно и видят уже сделанные в этом проходе перемещения
+/// соседей, поэтому при нескольких потоках результат может зависеть от их планирования.
+#ifndef GRAVIS24_ALGORITHM_COMMUNITIES_HPP
+#define GRAVIS24_ALGORITHM_COMMUNITIES_HPP
+
+#include "graph.hpp"
+
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Если алгоритм не смог выполниться (нет столбца весов, отрицательный вес или NaN),
+    /// communities пуст.
+    struct Communities
+    {
+        /// Номер сообщества каждой вершины (номера идут подряд в порядке первых вершин).
+        std::vector<int> communities;
+        int              communityCount {};
+        /// Модулярность разбиения (с учётом resolution для метода Лувена).
+        float            modularity     {};
+    };
+
+
+    struct LouvainOptions
+    {
+        /// Параметр разрешения: больше 1 -- сообщества мельче, меньше 1 -- крупнее.
+        float resolution = 1.f;
+        /// Предельное число уровней (сжатий графа).
+        int   maxLevels  = 32;
+        /// Предельное число проходов по вершинам на одном уровне; уровень заканчивается
+        /// и раньше, если за проход переместилось не больше 0.1% вершин.
+        int   maxSweeps  = 32;
+        /// Уровень, улучшивший модулярность меньше чем на tolerance, последний.
+        float tolerance  = 1e-6f;
+    };
+
+
+    /// @brief                 Распространение меток: вершина принимает метку с наибольшим суммарным
+    ///                        весом среди соседей (при равенстве -- свою или псевдослучайную),
+    ///                        пока за проход меняется больше 0.1% меток.
+    ///                        Веса меток собираются в хэш-таблицах потоков.
+    /// @param el              список дуг
+    /// @param vertexCount     количество вершин графа
+    /// @param weightAttribute номер столбца float с весами; -1 -- все веса равны 1
+    /// @param maxIterations   предельное число проходов по вершинам
+    [[nodiscard]] auto computeLabelPropagation(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute,
+            int                 maxIterations = 32
+        ) -> Communities;
+
+    [[nodiscard]] auto computeLabelPropagation(
+            Graph const& graph,
+            int          weightAttribute,
+            int          maxIterations = 32
+        ) -> Communities;
+
+    /// @brief Метод Лувена: параллельные локальные перемещения вершин между сообществами
+    ///        (веса связей с соседними сообществами -- в хэш-таблицах потоков),
+    ///        затем сжатие сообществ в вершины следующего уровня.
+    [[nodiscard]] auto computeLouvain(
+            EdgeListView const&   el,
+            int                   vertexCount,
+            int                   weightAttribute,
+            LouvainOptions const& options = {}
+        ) -> Communities;
+
+    [[nodiscard]] auto computeLouvain(
+            Graph const&          graph,
+            int                   weightAttribute,
+            LouvainOptions const& options = {}
+        ) -> Communities;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_COMMUNITIES_HPP
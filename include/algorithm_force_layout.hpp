@@ -0,0 +1,72 @@
+/// @file algorithm_force_layout.hpp
+/// @brief Силовая укладка графа в пространстве (Фрюхтерман -- Рейнгольд)
+///        с октодеревом Барнса -- Хата для отталкивания.
+///
+/// Граф рассматривается как неориентированный, петли и кратные дуги не учитываются.
+/// Силы на вершину: отталкивание от всех вершин k^2 / d, притяжение к соседям d^2 / k,
+/// притяжение к началу координат gravity * d. За итерацию вершина смещается вдоль
+/// суммарной силы не больше чем на "температуру", которая линейно убывает до нуля.
+///
+/// События (если есть подписчики):
+/// VertexPositionChanged -- после каждой итерации для каждой вершины.
+#ifndef GRAVIS24_ALGORITHM_FORCE_LAYOUT_HPP
+#define GRAVIS24_ALGORITHM_FORCE_LAYOUT_HPP
+
+#include "event_broadcaster.hpp"
+#include "graph.hpp"
+
+#include <cstdint>
+#include <span>
+
+
+namespace gravis24::algorithm
+{
+
+    struct ForceLayoutOptions
+    {
+        int      iterations         = 200;
+        /// Желаемая длина ребра k.
+        float    idealDistance      = 1.f;
+        /// Параметр Барнса -- Хата: ячейка размера s на расстоянии d заменяется
+        /// центром масс, если s < theta * d. 0 -- точный расчёт O(V^2).
+        float    theta              = 0.8f;
+        float    gravity            = 0.01f;
+        /// Начальная температура; 0 -- половина ожидаемого размера укладки k * V^(1/3).
+        float    initialTemperature = 0.f;
+        /// Для начального случайного размещения, если все координаты нулевые.
+        uint64_t seed               = 0;
+    };
+
+
+    /// Итерация: октодерево строится по текущим координатам, затем силы для всех вершин
+    /// считаются параллельно (каждая вершина обходит дерево и свои рёбра, поэтому записи
+    /// не пересекаются и результат не зависит от числа потоков). Итерация -- O(V log V + E).
+    class ForceDirectedLayout
+        : public EventBroadcaster
+    {
+    public:
+        explicit ForceDirectedLayout(ForceLayoutOptions const& options = {}) noexcept
+            : _options(options)
+        {
+            // Пусто.
+        }
+
+        /// @brief           Уложить граф, начиная с заданных координат.
+        /// @param positions координаты вершин (вход и выход); все нулевые -- случайное размещение
+        /// @return          false (и координаты не изменены), если размер positions не равен числу вершин
+        bool run(AdjacencyListView const& al, VertexPositionArrays& positions);
+
+        /// @brief То же для массива структур (копируется в структуру массивов и обратно).
+        bool run(AdjacencyListView const& al, std::span<XYZ> positions);
+
+        /// @brief Уложить граф прямо в его массивах координат
+        ///        (ChangeableVertexPositionArrays, одно уведомление графа).
+        bool run(Graph& graph);
+
+    private:
+        ForceLayoutOptions _options;
+    };
+
+}
+
+#endif//GRAVIS24_ALGORITHM_FORCE_LAYOUT_HPP
@@ -0,0 +1,58 @@
+/// @file algorithm_k_core.hpp
+/// @brief Разложение на k-ядра и порядок вырожденности.
+///
+/// k-ядро -- наибольший подграф, в котором степень каждой вершины не меньше k;
+/// номер ядра вершины -- наибольшее такое k. Граф рассматривается как неориентированный
+/// простой (направления, петли и кратные дуги не учитываются).
+/// Номера ядер можно записать в целочисленный атрибут вершин (storeVertexIntAttributes
+/// или перегрузка для EditableAdjacencyList), порядок вырожденности используется
+/// жадной раскраской smallest-last (algorithm_coloring.hpp).
+#ifndef GRAVIS24_ALGORITHM_K_CORE_HPP
+#define GRAVIS24_ALGORITHM_K_CORE_HPP
+
+#include "adjacency_list.hpp"
+#include "compressed_adjacency.hpp"
+
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct CoreDecomposition
+    {
+        /// Номер ядра каждой вершины.
+        std::vector<int> coreNumbers;
+        /// Вершины в порядке удаления: у каждой вершины не больше degeneracy соседей,
+        /// стоящих в порядке позже неё.
+        std::vector<int> degeneracyOrder;
+        /// Вырожденность графа -- наибольший номер ядра.
+        int              degeneracy {};
+    };
+
+
+    /// @brief Алгоритм Батагеля -- Заверсника: вершины в корзинах по текущей степени,
+    ///        удаление вершины наименьшей степени за O(1), всего O(V + E).
+    [[nodiscard]] auto computeCoreDecomposition(AdjacencyListView const& al)
+        -> CoreDecomposition;
+
+    /// @brief            То же для готового неориентированного графа.
+    /// @param undirected симметричный граф без петель и кратных рёбер (CompressedAdjacency::symmetrized)
+    [[nodiscard]] auto computeCoreDecomposition(CompressedAdjacency const& undirected)
+        -> CoreDecomposition;
+
+    /// @brief               Разложение с записью номеров ядер в атрибут вершин.
+    /// @param coreAttribute номер целочисленного атрибута
+    /// @return              пустой результат (и ничего не записано), если атрибута нет
+    [[nodiscard]] auto computeCoreDecomposition(EditableAdjacencyList& al, int coreAttribute)
+        -> CoreDecomposition;
+
+    /// @brief Параллельное "отслаивание": для k = 0, 1, ... все вершины степени не больше k
+    ///        удаляются волнами, волна обрабатывается параллельно (степени соседей
+    ///        уменьшаются атомарно). Порядок вершин внутри волны -- по возрастанию номеров.
+    [[nodiscard]] auto computeCoreDecompositionParallel(AdjacencyListView const& al)
+        -> CoreDecomposition;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_K_CORE_HPP
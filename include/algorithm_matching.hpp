@@ -0,0 +1,123 @@
+/// @file algorithm_matching.hpp
+/// @brief Паросочетания: наибольшее в двудольном графе (Хопкрофт -- Карп),
+///        жадные максимальные (по порядку вершин, Карп -- Сипсер) и параллельное приближённое.
+///
+/// Граф рассматривается как неориентированный (arcs в любом направлении -- рёбра),
+/// петли и кратные дуги не учитываются. Максимальное (по включению) паросочетание
+/// не меньше половины наибольшего.
+///
+/// События (если есть подписчики):
+/// ArcIsMatched -- ребро вошло в паросочетание (в итоговое для Хопкрофта -- Карпа).
+#ifndef GRAVIS24_ALGORITHM_MATCHING_HPP
+#define GRAVIS24_ALGORITHM_MATCHING_HPP
+
+#include "event_broadcaster.hpp"
+#include "graph.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Если алгоритм не смог выполниться (граф не двудольный для Хопкрофта -- Карпа),
+    /// mates пуст.
+    struct Matching
+    {
+        /// Пара каждой вершины, -1 -- вершина свободна.
+        std::vector<int> mates;
+        /// Число рёбер паросочетания.
+        int              size {};
+    };
+
+
+    /// Жадное построение максимального паросочетания.
+    enum class MatchingHeuristic
+    {
+        /// Свободная вершина по возрастанию номеров берёт первого свободного соседа.
+        Greedy,
+        /// Карп -- Сипсер: пока есть вершина с одним свободным соседом, берётся это ребро
+        /// (оно входит в некоторое наибольшее паросочетание); иначе очередная вершина
+        /// берёт свободного соседа с наименьшим числом свободных соседей. O(V + E).
+        KarpSipser
+    };
+
+
+    class GreedyMatching
+        : public EventBroadcaster
+    {
+    public:
+        explicit GreedyMatching(MatchingHeuristic heuristic = MatchingHeuristic::KarpSipser) noexcept
+            : _heuristic(heuristic)
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto run(AdjacencyListView const& al)
+            -> Matching;
+
+        [[nodiscard]] auto run(Graph const& graph)
+            -> Matching;
+
+    private:
+        MatchingHeuristic _heuristic;
+    };
+
+
+    /// Параллельное максимальное паросочетание для произвольного графа ("рукопожатия"):
+    /// вершинам назначаются случайные приоритеты; в каждом раунде свободная вершина
+    /// параллельно выбирает свободного соседа с наибольшим приоритетом, взаимно выбравшие
+    /// друг друга вершины образуют пару. Вершина наибольшего приоритета всегда находит пару,
+    /// поэтому раунды заканчиваются. Результат зависит только от seed, но не от числа потоков.
+    class ParallelMatching
+        : public EventBroadcaster
+    {
+    public:
+        explicit ParallelMatching(uint64_t seed = 0) noexcept
+            : _seed(seed)
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto run(AdjacencyListView const& al)
+            -> Matching;
+
+        [[nodiscard]] auto run(Graph const& graph)
+            -> Matching;
+
+    private:
+        uint64_t _seed;
+    };
+
+
+    /// Алгоритм Хопкрофта -- Карпа: доли определяются раскраской в два цвета (в каждой
+    /// компоненте вершина с наименьшим номером -- в левой доле). Начальное паросочетание
+    /// строится жадно, затем фазы: обход в ширину от свободных левых вершин строит слои
+    /// до ближайших свободных правых, итеративный поиск в глубину по слоям находит
+    /// максимальный набор непересекающихся кратчайших увеличивающих путей.
+    /// Не более O(sqrt(V)) фаз, всего O(E sqrt(V)).
+    class HopcroftKarp
+        : public EventBroadcaster
+    {
+    public:
+        explicit HopcroftKarp(MatchingHeuristic initialization = MatchingHeuristic::KarpSipser) noexcept
+            : _initialization(initialization)
+        {
+            // Пусто.
+        }
+
+        /// @return наибольшее паросочетание; пустой результат, если граф не двудольный
+        [[nodiscard]] auto run(AdjacencyListView const& al)
+            -> Matching;
+
+        [[nodiscard]] auto run(Graph const& graph)
+            -> Matching;
+
+    private:
+        MatchingHeuristic _initialization;
+    };
+
+}
+
+#endif//GRAVIS24_ALGORITHM_MATCHING_HPP
@@ -0,0 +1,70 @@
+/// @file algorithm_max_flow.hpp
+/// @brief Максимальный поток и минимальный разрез (проталкивание предпотока).
+///
+/// Пропускные способности дуг -- столбец атрибутов списка дуг (float или int,
+/// EdgeListView::getFloatAttributes / getIntAttributes). Потоки по дугам можно записать
+/// обратно в столбец атрибутов функциями storeArcFloatAttributes / storeArcIntAttributes
+/// (attribute_columns.hpp), принадлежность вершин разрезу -- storeVertexIntAttributes.
+#ifndef GRAVIS24_ALGORITHM_MAX_FLOW_HPP
+#define GRAVIS24_ALGORITHM_MAX_FLOW_HPP
+
+#include "graph.hpp"
+
+#include <span>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Если алгоритм не смог выполниться (неверные вершины, source == sink,
+    /// столбец короче списка дуг, отрицательная или бесконечная пропускная способность, NaN),
+    /// все массивы пусты.
+    template <typename Capacity>
+    struct MaxFlow
+    {
+        /// Величина потока (сумма для целых пропускных способностей точна до 2^53).
+        double                value {};
+        /// Поток по каждой дуге (номера как в EdgeListView), 0 для петель и дуг с неверными вершинами.
+        std::vector<Capacity> arcFlows;
+        /// 1 -- вершина в части минимального разреза, содержащей источник, иначе 0
+        /// (из минимальных разрезов выбирается разрез с наименьшей частью стока).
+        std::vector<int>      sourceSide;
+    };
+
+
+    /// @brief             Проталкивание предпотока с выбором активной вершины наибольшей высоты,
+    ///                    эвристиками разрыва (gap) и периодического глобального пересчёта высот.
+    ///                    Работает на остаточном графе в форме CSR, в котором у каждой дуги
+    ///                    хранится номер парной обратной дуги.
+    /// @param el          список дуг
+    /// @param vertexCount количество вершин графа
+    /// @param capacities  пропускные способности по номерам дуг (не короче el.getArcs())
+    [[nodiscard]] auto computeMaxFlow(
+            EdgeListView const&    el,
+            int                    vertexCount,
+            std::span<float const> capacities,
+            int                    source,
+            int                    sink
+        ) -> MaxFlow<float>;
+
+    /// @brief Целочисленные пропускные способности: вычисления без округлений.
+    [[nodiscard]] auto computeMaxFlow(
+            EdgeListView const&    el,
+            int                    vertexCount,
+            std::span<int const>   capacities,
+            int                    source,
+            int                    sink
+        ) -> MaxFlow<int>;
+
+    /// @brief Пропускные способности из столбца float capacityAttribute списка дуг графа.
+    [[nodiscard]] auto computeMaxFlow(
+            Graph const& graph,
+            int          capacityAttribute,
+            int          source,
+            int          sink
+        ) -> MaxFlow<float>;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_MAX_FLOW_HPP
@@ -0,0 +1,99 @@
+/// @file algorithm_page_rank.hpp
+/// @brief PageRank, персонализированный PageRank и степенной метод для разреженных матриц.
+///
+/// Вычисления ведутся "вытягиванием" (pull): новое значение вершины -- сумма по входящим
+/// дугам, поэтому каждая вершина пишет только своё значение и блоки вершин обрабатываются
+/// параллельно без синхронизации. Входящие дуги берутся из транспонированного
+/// CompressedAdjacency, значения хранятся в непрерывных массивах float.
+///
+/// Результат можно записать в атрибут float вершин (storeVertexFloatAttributes
+/// или перегрузка computePageRank для EditableAdjacencyList), чтобы затем
+/// отобразить его, например, в VertexRadiusChanged.
+#ifndef GRAVIS24_ALGORITHM_PAGE_RANK_HPP
+#define GRAVIS24_ALGORITHM_PAGE_RANK_HPP
+
+#include "adjacency_list.hpp"
+#include "compressed_adjacency.hpp"
+
+#include <span>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct PowerIterationOptions
+    {
+        /// Вероятность перехода по дуге (для PageRank).
+        float damping       = 0.85f;
+        /// Порог сходимости: сумма модулей изменений значений за итерацию.
+        float tolerance     = 1e-6f;
+        /// Предельное число итераций.
+        int   maxIterations = 100;
+    };
+
+
+    /// Если вычисление невозможно (неверные параметры), values пуст.
+    struct PowerIteration
+    {
+        /// Значения по вершинам, сумма равна 1.
+        std::vector<float> values;
+        /// Оценка наибольшего собственного числа (для PageRank равна 1).
+        float              eigenvalue {};
+        /// Сумма модулей изменений на последней итерации.
+        float              residual   {};
+        int                iterations {};
+        bool               converged  {};
+    };
+
+
+    /// @brief         y = A x, где строка v матрицы A -- дуги pull.getTargets(v)
+    ///                (номера столбцов) со значениями arcValues в порядке CSR.
+    /// @param pull    обычно транспонированный граф: строка v -- входящие в v дуги
+    /// @return        false (y не изменён), если размеры не согласованы
+    bool multiplyPull(
+            CompressedAdjacency const& pull,
+            std::span<float const>     arcValues,
+            std::span<float const>     x,
+            std::span<float>           y
+        );
+
+    /// @brief           Степенной метод для неотрицательной матрицы A (см. multiplyPull):
+    ///                  x <- A x / |A x|, начиная с равномерного вектора.
+    ///                  Например, центральность по собственному вектору: pull -- входящие дуги,
+    ///                  arcValues -- единицы.
+    /// @param arcValues значения дуг в порядке CSR pull (см. CompressedAdjacency::gather)
+    [[nodiscard]] auto computeDominantEigenvector(
+            CompressedAdjacency const&   pull,
+            std::span<float const>       arcValues,
+            PowerIterationOptions const& options = {}
+        ) -> PowerIteration;
+
+    /// @brief Классический PageRank; "висячие" вершины (без исходящих дуг)
+    ///        раздают свой вес равномерно всем вершинам.
+    [[nodiscard]] auto computePageRank(
+            AdjacencyListView const&     al,
+            PowerIterationOptions const& options = {}
+        ) -> PowerIteration;
+
+    /// @brief                 Персонализированный PageRank: телепортация (и вес висячих вершин)
+    ///                        распределяется пропорционально personalization.
+    /// @param personalization неотрицательные веса вершин с положительной суммой
+    [[nodiscard]] auto computePersonalizedPageRank(
+            AdjacencyListView const&     al,
+            std::span<float const>       personalization,
+            PowerIterationOptions const& options = {}
+        ) -> PowerIteration;
+
+    /// @brief               PageRank с записью результата в атрибут вершин.
+    /// @param rankAttribute номер атрибута float, в который записываются значения
+    /// @return              пустой результат (и ничего не записано), если атрибута нет
+    [[nodiscard]] auto computePageRank(
+            EditableAdjacencyList&       al,
+            int                          rankAttribute,
+            PowerIterationOptions const& options = {}
+        ) -> PowerIteration;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_PAGE_RANK_HPP
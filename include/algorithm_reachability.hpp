@@ -0,0 +1,52 @@
+/// @file algorithm_reachability.hpp
+/// @brief Сильно связные компоненты и транзитивное замыкание (матрица достижимости).
+///
+/// Транзитивное замыкание содержит дугу (i, j), если из i в j есть путь
+/// из одной или более дуг; в частности, (i, i) есть только для вершин на циклах.
+#ifndef GRAVIS24_ALGORITHM_REACHABILITY_HPP
+#define GRAVIS24_ALGORITHM_REACHABILITY_HPP
+
+#include "graph.hpp"
+
+#include <memory>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct StronglyConnectedComponents
+    {
+        /// Номер компоненты каждой вершины. Номера идут в обратном топологическом
+        /// порядке конденсации: дуга между разными компонентами ведёт в компоненту
+        /// с меньшим номером.
+        std::vector<int> components;
+        int              componentCount {};
+    };
+
+
+    /// @brief Алгоритм Тарьяна (без рекурсии), O(V + E).
+    [[nodiscard]] auto computeStronglyConnectedComponents(AdjacencyListView const& al)
+        -> StronglyConnectedComponents;
+
+
+    /// @brief Битово-параллельный алгоритм Уоршелла: для каждого k строка k
+    ///        объединяется (OR по 64-битным словам) со всеми строками, содержащими k.
+    ///        O(V^3 / 64), строки распределены между потоками.
+    [[nodiscard]] auto computeTransitiveClosure(DenseAdjacencyMatrixView const& am)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>;
+
+    /// @brief Для разреженных графов: замыкание конденсации (по компонентам сильной
+    ///        связности в обратном топологическом порядке), затем развёртывание по вершинам.
+    ///        O(V + E * C / 64), где C -- число компонент.
+    [[nodiscard]] auto computeTransitiveClosure(AdjacencyListView const& al)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>;
+
+    /// @brief Выбирает способ по плотности графа: при числе дуг не меньше V^2 / 64
+    ///        используется матрица смежности, иначе -- списки смежности.
+    [[nodiscard]] auto computeTransitiveClosure(Graph const& graph)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_REACHABILITY_HPP
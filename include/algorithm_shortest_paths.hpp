@@ -0,0 +1,89 @@
+/// @file algorithm_shortest_paths.hpp
+/// @brief Кратчайшие пути из одной вершины для неотрицательных весов дуг.
+///
+/// Веса берутся из столбца атрибутов float списка дуг (EdgeListView::getFloatAttributes).
+/// Результаты -- массивы по вершинам, которые можно записать в атрибуты вершин
+/// функциями storeVertexFloatAttributes / storeVertexIntAttributes (attribute_columns.hpp).
+///
+/// События (если есть подписчики):
+/// VertexIsOpened -- вершина впервые достигнута,
+/// ArcIsTree      -- дуга стала (новой) дугой дерева кратчайших путей,
+/// VertexIsClosed -- расстояние до вершины окончательно.
+#ifndef GRAVIS24_ALGORITHM_SHORTEST_PATHS_HPP
+#define GRAVIS24_ALGORITHM_SHORTEST_PATHS_HPP
+
+#include "event_broadcaster.hpp"
+#include "graph.hpp"
+
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Если алгоритм не смог выполниться (неверная вершина, нет столбца весов,
+    /// отрицательный вес), все массивы пусты.
+    struct ShortestPaths
+    {
+        /// Расстояния от источника, +бесконечность для недостижимых вершин.
+        std::vector<float> distances;
+        /// Предыдущая вершина на кратчайшем пути, -1 для источника и недостижимых вершин.
+        std::vector<int>   parents;
+        /// Номер (в EdgeListView) дуги, ведущей из parents[v] в v, или -1.
+        std::vector<int>   parentArcs;
+    };
+
+
+    /// Алгоритм Дейкстры с 4-арной кучей (уменьшение ключа по номеру вершины).
+    class Dijkstra
+        : public EventBroadcaster
+    {
+    public:
+        /// @param el              список дуг
+        /// @param vertexCount     количество вершин графа
+        /// @param weightAttribute номер столбца float с весами; -1 -- все веса равны 1
+        /// @param source          начальная вершина
+        [[nodiscard]] auto run(
+                EdgeListView const& el,
+                int                 vertexCount,
+                int                 weightAttribute,
+                int                 source
+            ) -> ShortestPaths;
+
+        [[nodiscard]] auto run(Graph const& graph, int weightAttribute, int source)
+            -> ShortestPaths;
+    };
+
+
+    /// Параллельный delta-stepping: вершины раскладываются по корзинам ширины delta,
+    /// "лёгкие" дуги (вес <= delta) корзины релаксируются параллельно до стабилизации,
+    /// затем однократно релаксируются "тяжёлые" дуги.
+    class DeltaStepping
+        : public EventBroadcaster
+    {
+    public:
+        /// @param delta ширина корзины; 0 -- выбрать как средний вес дуги;
+        ///              при отрицательном или бесконечном delta и NaN run возвращает пустой результат
+        explicit DeltaStepping(float delta = 0.f) noexcept
+            : _delta(delta)
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto run(
+                EdgeListView const& el,
+                int                 vertexCount,
+                int                 weightAttribute,
+                int                 source
+            ) -> ShortestPaths;
+
+        [[nodiscard]] auto run(Graph const& graph, int weightAttribute, int source)
+            -> ShortestPaths;
+
+    private:
+        float _delta {};
+    };
+
+}
+
+#endif//GRAVIS24_ALGORITHM_SHORTEST_PATHS_HPP
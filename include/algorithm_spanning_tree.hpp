@@ -0,0 +1,76 @@
+/// @file algorithm_spanning_tree.hpp
+/// @brief Минимальный остовный лес (в каждой компоненте связности -- минимальное остовное дерево).
+///
+/// Дуги рассматриваются как неориентированные рёбра, петли пропускаются.
+/// Веса берутся из столбца атрибутов float списка дуг (EdgeListView::getFloatAttributes).
+/// При равных весах меньшим считается ребро с меньшим номером дуги,
+/// поэтому оба алгоритма строят один и тот же лес.
+///
+/// События (если есть подписчики):
+/// ArcIsTree -- ребро добавлено в остовный лес.
+#ifndef GRAVIS24_ALGORITHM_SPANNING_TREE_HPP
+#define GRAVIS24_ALGORITHM_SPANNING_TREE_HPP
+
+#include "event_broadcaster.hpp"
+#include "graph.hpp"
+
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Если алгоритм не смог выполниться (нет столбца весов, вес NaN),
+    /// arcs пуст и treeCount == 0.
+    struct SpanningForest
+    {
+        /// Номера (в EdgeListView) дуг леса в порядке добавления.
+        std::vector<int> arcs;
+        /// Сумма весов дуг леса.
+        double           totalWeight {};
+        /// Число деревьев, включая изолированные вершины.
+        int              treeCount   {};
+    };
+
+
+    /// Алгоритм Краскала: номера дуг сортируются по весу параллельно
+    /// (сами дуги и столбцы атрибутов не перемещаются), затем дуги
+    /// просматриваются по возрастанию с системой непересекающихся множеств.
+    class Kruskal
+        : public EventBroadcaster
+    {
+    public:
+        /// @param el              список дуг
+        /// @param vertexCount     количество вершин графа
+        /// @param weightAttribute номер столбца float с весами; -1 -- все веса равны 1
+        [[nodiscard]] auto run(
+                EdgeListView const& el,
+                int                 vertexCount,
+                int                 weightAttribute
+            ) -> SpanningForest;
+
+        [[nodiscard]] auto run(Graph const& graph, int weightAttribute)
+            -> SpanningForest;
+    };
+
+
+    /// Параллельный алгоритм Борувки: на каждом раунде все рёбра параллельно
+    /// предлагают себя как лёгкие для своих компонент, выбранные рёбра сливают
+    /// компоненты, рёбра внутри компонент отбрасываются. Не более log2(V) раундов.
+    class Boruvka
+        : public EventBroadcaster
+    {
+    public:
+        [[nodiscard]] auto run(
+                EdgeListView const& el,
+                int                 vertexCount,
+                int                 weightAttribute
+            ) -> SpanningForest;
+
+        [[nodiscard]] auto run(Graph const& graph, int weightAttribute)
+            -> SpanningForest;
+    };
+
+}
+
+#endif//GRAVIS24_ALGORITHM_SPANNING_TREE_HPP
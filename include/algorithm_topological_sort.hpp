@@ -0,0 +1,92 @@
+/// @file algorithm_topological_sort.hpp
+/// @brief Топологическая сортировка, разбиение на волны (уровни) и самые длинные пути в DAG.
+///
+/// Волна k -- вершины, все предшественники которых лежат в волнах 0 .. k-1.
+/// Вершины одной волны независимы и могут обрабатываться параллельно,
+/// поэтому волны -- готовое расписание для графа задач.
+#ifndef GRAVIS24_ALGORITHM_TOPOLOGICAL_SORT_HPP
+#define GRAVIS24_ALGORITHM_TOPOLOGICAL_SORT_HPP
+
+#include "graph.hpp"
+
+#include <span>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    /// Если граф содержит цикл, оба массива пусты.
+    struct Wavefronts
+    {
+        /// Вершины по волнам, внутри волны -- по возрастанию номеров.
+        std::vector<int> vertices;
+        /// Волна k -- vertices[offsets[k], offsets[k + 1]).
+        std::vector<int> offsets;
+
+        [[nodiscard]] auto getWaveCount() const noexcept
+            -> int
+        {
+            return static_cast<int>(offsets.size()) - (offsets.empty()? 0: 1);
+        }
+
+        /// @brief Предусловие: 0 <= wave < getWaveCount().
+        [[nodiscard]] auto getWave(int wave) const noexcept
+            -> std::span<int const>
+        {
+            auto const begin = static_cast<size_t>(offsets[wave]);
+            auto const end   = static_cast<size_t>(offsets[wave + 1]);
+            return std::span<int const>(vertices).subspan(begin, end - begin);
+        }
+    };
+
+
+    /// Если граф содержит цикл (или не смог выполниться: нет столбца весов, вес NaN),
+    /// все массивы пусты.
+    struct LongestPaths
+    {
+        /// Длина самого длинного пути, оканчивающегося в вершине (пути начинаются в любой вершине).
+        std::vector<float> distances;
+        /// Предыдущая вершина на таком пути, -1 если путь состоит из одной вершины.
+        std::vector<int>   parents;
+        /// Номер (в EdgeListView) дуги, ведущей из parents[v] в v, или -1.
+        std::vector<int>   parentArcs;
+        /// Вершины критического (самого длинного) пути графа от начала к концу.
+        std::vector<int>   criticalPath;
+        /// Длина критического пути.
+        float              length {};
+    };
+
+
+    /// @brief  Полустепени захода (число входящих дуг) всех вершин.
+    [[nodiscard]] auto computeInDegrees(AdjacencyListView const& al)
+        -> std::vector<int>;
+
+    /// @brief  Алгоритм Кана: очередь вершин с нулевой полустепенью захода.
+    /// @return все вершины в топологическом порядке или пустой массив, если есть цикл
+    [[nodiscard]] auto sortTopologically(AdjacencyListView const& al)
+        -> std::vector<int>;
+
+    /// @brief Алгоритм Кана по уровням: волны строятся по очереди, вершины волны
+    ///        обрабатываются параллельно (счётчики входящих дуг уменьшаются атомарно).
+    [[nodiscard]] auto computeWavefronts(AdjacencyListView const& al)
+        -> Wavefronts;
+
+    /// @brief                 Самые длинные пути (критический путь) в ациклическом графе.
+    ///                        Волны обрабатываются по очереди, вершины волны -- параллельно:
+    ///                        каждая вершина выбирает лучшую из входящих дуг.
+    /// @param el              список дуг
+    /// @param vertexCount     количество вершин графа
+    /// @param weightAttribute номер столбца float с длительностями дуг; -1 -- все равны 1
+    [[nodiscard]] auto computeLongestPaths(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute
+        ) -> LongestPaths;
+
+    [[nodiscard]] auto computeLongestPaths(Graph const& graph, int weightAttribute)
+        -> LongestPaths;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_TOPOLOGICAL_SORT_HPP
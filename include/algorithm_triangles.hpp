@@ -0,0 +1,52 @@
+/// @file algorithm_triangles.hpp
+/// @brief Подсчёт треугольников и коэффициенты кластеризации.
+///
+/// Граф рассматривается как неориентированный простой: направления дуг,
+/// петли и кратные дуги не учитываются. Каждое ребро ориентируется от вершины
+/// меньшей степени к вершине большей степени, поэтому каждый треугольник
+/// находится ровно один раз пересечением двух окрестностей.
+#ifndef GRAVIS24_ALGORITHM_TRIANGLES_HPP
+#define GRAVIS24_ALGORITHM_TRIANGLES_HPP
+
+#include "adjacency_list.hpp"
+#include "dense_adjacency_matrix.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace gravis24::algorithm
+{
+
+    struct ClusteringCoefficients
+    {
+        /// Число треугольников, содержащих вершину.
+        std::vector<int64_t> triangles;
+        /// Локальный коэффициент кластеризации (0 для вершин степени меньше 2).
+        std::vector<float>   local;
+        /// Общее число треугольников.
+        int64_t              triangleCount     {};
+        /// Глобальный коэффициент: 3 * треугольники / число путей длины 2.
+        float                transitivity      {};
+        /// Среднее локальных коэффициентов по всем вершинам.
+        float                averageClustering {};
+    };
+
+
+    /// @brief Пересечение упорядоченных окрестностей слиянием (блоками по 8 на AVX2).
+    [[nodiscard]] auto countTriangles(AdjacencyListView const& al)
+        -> int64_t;
+
+    /// @brief Пересечение строк матрицы: popcount(rowA & rowB) по 64-битным словам.
+    [[nodiscard]] auto countTriangles(DenseAdjacencyMatrixView const& am)
+        -> int64_t;
+
+    [[nodiscard]] auto computeClusteringCoefficients(AdjacencyListView const& al)
+        -> ClusteringCoefficients;
+
+    [[nodiscard]] auto computeClusteringCoefficients(DenseAdjacencyMatrixView const& am)
+        -> ClusteringCoefficients;
+
+}
+
+#endif//GRAVIS24_ALGORITHM_TRIANGLES_HPP
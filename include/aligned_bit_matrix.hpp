@@ -0,0 +1,108 @@
+/// @file aligned_bit_matrix.hpp
+#ifndef GRAVIS24_ALIGNED_BIT_MATRIX_HPP
+#define GRAVIS24_ALIGNED_BIT_MATRIX_HPP
+
+#include "dense_adjacency_matrix.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace gravis24
+{
+
+    /// Битовая матрица для вычислений: каждая строка начинается с нового 64-битного слова
+    /// (в отличие от DenseAdjacencyMatrix, где строки идут подряд без выравнивания),
+    /// поэтому строки можно объединять и пересекать пословно.
+    class AlignedBitMatrix
+    {
+    public:
+        using Word = uint64_t;
+        static constexpr int wordBits = 64;
+
+        AlignedBitMatrix() noexcept = default;
+
+        AlignedBitMatrix(int rowCount, int columnCount)
+            : _rowWords{ (static_cast<size_t>(columnCount) + wordBits - 1) / wordBits }
+            , _words(_rowWords * static_cast<size_t>(rowCount))
+        {
+            // Пусто.
+        }
+
+        /// @brief Скопировать матрицу смежности.
+        [[nodiscard]] static auto fromAdjacencyMatrix(DenseAdjacencyMatrixView const& am)
+            -> AlignedBitMatrix
+        {
+            auto const vertexCount = am.getVertexCount();
+            AlignedBitMatrix result(vertexCount, vertexCount);
+            for (int i = 0; i < vertexCount; ++i)
+            {
+                auto const row = am.getRow(i);
+                for (int j = 0; j < vertexCount; ++j)
+                    if (row.getBit(j))
+                        result.set(i, j);
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] auto row(int i) noexcept
+            -> Word*
+        {
+            return _words.data() + i * _rowWords;
+        }
+
+        [[nodiscard]] auto row(int i) const noexcept
+            -> Word const*
+        {
+            return _words.data() + i * _rowWords;
+        }
+
+        [[nodiscard]] auto getRowWords() const noexcept
+            -> size_t
+        {
+            return _rowWords;
+        }
+
+        [[nodiscard]] bool get(int i, int j) const noexcept
+        {
+            return (row(i)[j / wordBits] >> (j % wordBits)) & 1;
+        }
+
+        void set(int i, int j) noexcept
+        {
+            row(i)[j / wordBits] |= Word{1} << (j % wordBits);
+        }
+
+        void reset(int i, int j) noexcept
+        {
+            row(i)[j / wordBits] &= ~(Word{1} << (j % wordBits));
+        }
+
+        void orRow(int destination, Word const* source) noexcept
+        {
+            auto const d = row(destination);
+            for (size_t w = 0; w < _rowWords; ++w)
+                d[w] |= source[w];
+        }
+
+        /// @brief Вызвать visit(j) для каждого единичного бита строки i.
+        template <typename Visit>
+        void forEachSetBit(int i, Visit visit) const
+        {
+            auto const r = row(i);
+            for (size_t w = 0; w < _rowWords; ++w)
+            {
+                for (auto bits = r[w]; bits != 0; bits &= bits - 1)
+                    visit(static_cast<int>(w * wordBits) + std::countr_zero(bits));
+            }
+        }
+
+    private:
+        size_t            _rowWords {};
+        std::vector<Word> _words;
+    };
+
+}
+
+#endif//GRAVIS24_ALIGNED_BIT_MATRIX_HPP
@@ -0,0 +1,50 @@
+/// @file attribute_columns.hpp
+/// @brief Запись результатов алгоритмов (по одному значению на вершину или дугу) в столбцы атрибутов.
+#ifndef GRAVIS24_ATTRIBUTE_COLUMNS_HPP
+#define GRAVIS24_ATTRIBUTE_COLUMNS_HPP
+
+#include "adjacency_list.hpp"
+#include "edge_list.hpp"
+
+#include <span>
+
+namespace gravis24
+{
+
+    /// @brief                Записать values[v] в целочисленный атрибут attributeIndex каждой вершины v.
+    /// @param attributeIndex номер атрибута (столбца)
+    /// @return               false (ничего не записано), если атрибута нет или values.size() != getVertexCount()
+    bool storeVertexIntAttributes(
+            EditableAdjacencyList& al,
+            int                    attributeIndex,
+            std::span<int const>   values
+        ) noexcept;
+
+    /// @brief                Записать values[v] в атрибут float номер attributeIndex каждой вершины v.
+    /// @param attributeIndex номер атрибута (столбца)
+    /// @return               false (ничего не записано), если атрибута нет или values.size() != getVertexCount()
+    bool storeVertexFloatAttributes(
+            EditableAdjacencyList& al,
+            int                    attributeIndex,
+            std::span<float const> values
+        ) noexcept;
+
+    /// @brief                Записать values в целочисленный столбец attributeIndex списка дуг.
+    /// @return               false (ничего не записано), если столбца нет или values.size() != getArcs().size()
+    bool storeArcIntAttributes(
+            EditableEdgeList&      el,
+            int                    attributeIndex,
+            std::span<int const>   values
+        ) noexcept;
+
+    /// @brief                Записать values в столбец float номер attributeIndex списка дуг.
+    /// @return               false (ничего не записано), если столбца нет или values.size() != getArcs().size()
+    bool storeArcFloatAttributes(
+            EditableEdgeList&      el,
+            int                    attributeIndex,
+            std::span<float const> values
+        ) noexcept;
+
+}
+
+#endif//GRAVIS24_ATTRIBUTE_COLUMNS_HPP
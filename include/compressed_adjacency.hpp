@@ -0,0 +1,133 @@
+/// @file compressed_adjacency.hpp
+/// @brief Сжатое представление окрестностей (CSR) для вычислительных алгоритмов.
+///
+/// В отличие от AdjacencyListView не требует виртуальных вызовов на каждую вершину:
+/// окрестности всех вершин лежат подряд в одном массиве.
+/// Для каждой дуги хранится её номер в исходном представлении (arc index),
+/// что позволяет обращаться к столбцам атрибутов EdgeListView без перемещения данных.
+#ifndef GRAVIS24_COMPRESSED_ADJACENCY_HPP
+#define GRAVIS24_COMPRESSED_ADJACENCY_HPP
+
+#include "edge_list.hpp"
+#include "adjacency_list.hpp"
+
+#include <span>
+#include <vector>
+
+namespace gravis24
+{
+
+    class CompressedAdjacency
+    {
+    public:
+        CompressedAdjacency() noexcept = default;
+
+        /// @brief Построить по списку дуг, номер дуги -- её индекс в el.getArcs().
+        ///        Дуги с вершинами вне [0, vertexCount) пропускаются.
+        ///        Порядок дуг одной вершины совпадает с порядком в списке.
+        [[nodiscard]] static auto fromEdgeList(EdgeListView const& el, int vertexCount)
+            -> CompressedAdjacency;
+
+        /// @brief Построить по спискам смежности, номер дуги -- её позиция в результате.
+        [[nodiscard]] static auto fromAdjacencyList(AdjacencyListView const& al)
+            -> CompressedAdjacency;
+
+        /// @brief Граф с обращёнными дугами (номера дуг сохраняются).
+        [[nodiscard]] auto transposed() const
+            -> CompressedAdjacency;
+
+        /// @brief Неориентированный простой граф: каждая дуга (s, t), s != t, даёт рёбра
+        ///        в обе стороны, петли и кратные рёбра удаляются, окрестности упорядочены
+        ///        по возрастанию. Номер ребра -- наименьший номер порождающей его дуги.
+        [[nodiscard]] auto symmetrized() const
+            -> CompressedAdjacency;
+
+        [[nodiscard]] auto getVertexCount() const noexcept
+            -> int
+        {
+            return static_cast<int>(_offsets.size()) - (_offsets.empty()? 0: 1);
+        }
+
+        [[nodiscard]] auto getArcCount() const noexcept
+            -> int
+        {
+            return static_cast<int>(_targets.size());
+        }
+
+        /// @brief Начала окрестностей: окрестность v занимает [offsets[v], offsets[v + 1]).
+        [[nodiscard]] auto getOffsets() const noexcept
+            -> std::span<int const>
+        {
+            return _offsets;
+        }
+
+        /// @brief Концы всех дуг подряд (по вершинам-началам).
+        [[nodiscard]] auto getAllTargets() const noexcept
+            -> std::span<int const>
+        {
+            return _targets;
+        }
+
+        /// @brief Номера всех дуг в исходном представлении (параллельно getAllTargets).
+        [[nodiscard]] auto getAllArcIndices() const noexcept
+            -> std::span<int const>
+        {
+            return _arcIndices;
+        }
+
+        /// @brief Предусловие: 0 <= vertex < getVertexCount().
+        [[nodiscard]] auto getTargetCount(int vertex) const noexcept
+            -> int
+        {
+            return _offsets[vertex + 1] - _offsets[vertex];
+        }
+
+        /// @brief Предусловие: 0 <= vertex < getVertexCount().
+        [[nodiscard]] auto getTargets(int vertex) const noexcept
+            -> std::span<int const>
+        {
+            return _range(_targets, vertex);
+        }
+
+        /// @brief Предусловие: 0 <= vertex < getVertexCount().
+        [[nodiscard]] auto getArcIndices(int vertex) const noexcept
+            -> std::span<int const>
+        {
+            return _range(_arcIndices, vertex);
+        }
+
+        /// @brief           Переупорядочить значения, заданные по номерам дуг, в порядок CSR.
+        /// @param arcValues значения для всех дуг исходного представления (например, столбец атрибута)
+        /// @return          массив длины getArcCount() или пустой, если arcValues слишком короток
+        template <typename T>
+        [[nodiscard]] auto gather(std::span<T const> arcValues) const
+            -> std::vector<T>
+        {
+            std::vector<T> result;
+            for (int const arc: _arcIndices)
+                if (static_cast<size_t>(arc) >= arcValues.size())
+                    return result;
+
+            result.reserve(_arcIndices.size());
+            for (int const arc: _arcIndices)
+                result.push_back(arcValues[arc]);
+            return result;
+        }
+
+    private:
+        std::vector<int> _offsets;
+        std::vector<int> _targets;
+        std::vector<int> _arcIndices;
+
+        [[nodiscard]] auto _range(std::vector<int> const& data, int vertex) const noexcept
+            -> std::span<int const>
+        {
+            auto const begin = static_cast<size_t>(_offsets[vertex]);
+            auto const end   = static_cast<size_t>(_offsets[vertex + 1]);
+            return std::span<int const>(data).subspan(begin, end - begin);
+        }
+    };
+
+}
+
+#endif//GRAVIS24_COMPRESSED_ADJACENCY_HPP
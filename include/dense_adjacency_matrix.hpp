@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <bit>
 
 namespace gravis24
@@ -266,6 +267,12 @@ namespace gravis24
     [[nodiscard]] auto newDenseAdjacencyMatrix(int vertexCount)
         -> std::unique_ptr<EditableDenseAdjacencyMatrix>;
 
+    /// @brief          То же, биты матрицы берут память у resource
+    ///                 (для больших матриц -- HugePageResource, см. memory_resources.hpp).
+    /// @param resource должен жить дольше матрицы
+    [[nodiscard]] auto newDenseAdjacencyMatrix(int vertexCount, std::pmr::memory_resource* resource)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>;
+
 
 }
 
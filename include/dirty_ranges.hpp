@@ -0,0 +1,86 @@
+/// @file dirty_ranges.hpp
+#ifndef GRAVIS24_DIRTY_RANGES_HPP
+#define GRAVIS24_DIRTY_RANGES_HPP
+
+#include <span>
+#include <vector>
+
+namespace gravis24
+{
+
+    /// Множество изменённых индексов в виде полуинтервалов [begin, end).
+    /// Добавление по возрастанию индексов (типичный случай) продлевает последний полуинтервал за O(1);
+    /// иначе полуинтервалы упорядочиваются и сливаются при normalize.
+    class DirtyRanges
+    {
+    public:
+        struct Range
+        {
+            int begin;
+            int end;
+        };
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _ranges.empty();
+        }
+
+        void clear() noexcept
+        {
+            _ranges.clear();
+            _isNormalized = true;
+        }
+
+        void add(int index)
+        {
+            add(index, index + 1);
+        }
+
+        /// @brief Добавить полуинтервал [begin, end); пустой игнорируется.
+        void add(int begin, int end)
+        {
+            if (begin >= end)
+                return;
+
+            if (!_ranges.empty())
+            {
+                auto& last = _ranges.back();
+                if (last.begin <= begin && begin <= last.end)
+                {
+                    if (last.end < end)
+                        last.end = end;
+                    return;
+                }
+
+                if (begin < last.begin)
+                    _isNormalized = false;
+            }
+
+            _ranges.push_back({ begin, end });
+        }
+
+        /// @brief Упорядочить полуинтервалы и слить пересекающиеся и соседние.
+        void normalize();
+
+        /// @brief Полуинтервалы; после normalize -- по возрастанию, не пересекаются и не соприкасаются.
+        [[nodiscard]] auto getRanges() const noexcept
+            -> std::span<Range const>
+        {
+            return _ranges;
+        }
+
+        /// @brief Число индексов (после normalize).
+        [[nodiscard]] auto getIndexCount() const noexcept
+            -> int;
+
+        /// @brief Входит ли индекс (после normalize), двоичный поиск.
+        [[nodiscard]] bool contains(int index) const noexcept;
+
+    private:
+        std::vector<Range> _ranges;
+        bool               _isNormalized = true;
+    };
+
+}
+
+#endif//GRAVIS24_DIRTY_RANGES_HPP
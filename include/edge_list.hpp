@@ -6,6 +6,7 @@
 
 #include <span>
 #include <memory> // unique_ptr
+#include <memory_resource>
 
 namespace gravis24
 {
@@ -97,6 +98,15 @@ namespace gravis24
             int floatAttrsCount   = 0
         ) -> std::unique_ptr<EditableEdgeList>;
 
+    /// @brief          То же, все массивы берут память у resource (см. memory_resources.hpp).
+    /// @param resource должен жить дольше списка
+    [[nodiscard]] auto newEdgeListUnsortedVector(
+            int                        preallocArcsCount,
+            int                        intAttrsCount,
+            int                        floatAttrsCount,
+            std::pmr::memory_resource* resource
+        ) -> std::unique_ptr<EditableEdgeList>;
+
 }
 
 #endif//GRAVIS24_EDGE_LIST_HPP
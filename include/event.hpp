@@ -30,6 +30,7 @@
 /// 7. Задан элемент (s, item, label)
 /// 8. Удалён элемент (s, item)
 /// 9. Помечен произвольный элемент стека (s, item).
+/// 10. Ребро вошло в паросочетание (u, v).
 /// 
 #ifndef GRAVIS24_EVENT_HPP
 #define GRAVIS24_EVENT_HPP
@@ -140,6 +141,11 @@ namespace gravis24
             Arc arc;
         };
 
+        struct ArcIsMatched
+        {
+            Arc arc;
+        };
+
         struct VertexLabelIsChanged
         {
             int vertex;
@@ -176,23 +182,24 @@ namespace gravis24
     } // events
 
     using Event = std::variant<
-                        VertexColorChanged,
-                        ArcColorChanged,
-                        VertexRadiusChanged,
-                        ArcWidthChanged,
-                        VertexPositionChanged,
-                        ItemColorChanged,
-                        VertexIsOpened,
-                        VertexIsClosed,
-                        ArcIsTree,
-                        ArcIsForward,
-                        ArcIsBackward,
-                        ArcIsCross,
-                        VertexLabelIsChanged,
-                        ArcLabelIsChanged,
-                        ItemIsSet,
-                        ItemIsRemoved,
-                        ItemIsMarked
+                        events::VertexColorChanged,
+                        events::ArcColorChanged,
+                        events::VertexRadiusChanged,
+                        events::ArcWidthChanged,
+                        events::VertexPositionChanged,
+                        events::ItemColorChanged,
+                        events::VertexIsOpened,
+                        events::VertexIsClosed,
+                        events::ArcIsTree,
+                        events::ArcIsForward,
+                        events::ArcIsBackward,
+                        events::ArcIsCross,
+                        events::ArcIsMatched,
+                        events::VertexLabelIsChanged,
+                        events::ArcLabelIsChanged,
+                        events::ItemIsSet,
+                        events::ItemIsRemoved,
+                        events::ItemIsMarked
                      >;
 
 }
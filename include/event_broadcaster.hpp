@@ -0,0 +1,40 @@
+/// @file event_broadcaster.hpp
+#ifndef GRAVIS24_EVENT_BROADCASTER_HPP
+#define GRAVIS24_EVENT_BROADCASTER_HPP
+
+#include "event_source.hpp"
+#include "event_listener.hpp"
+
+#include <vector>
+
+
+namespace gravis24
+{
+
+    /// Источник событий, хранящий список подписчиков и рассылающий им события.
+    /// Базовый класс для алгоритмов, которые (по желанию) сообщают о ходе работы.
+    class EventBroadcaster
+        : public EventSource
+    {
+    public:
+        void subscribe(EventListener&) override;
+        void unsubscribe(EventListener&) override;
+        [[nodiscard]] bool isSubscribed(EventListener&) const noexcept override;
+
+        /// Есть ли хотя бы один подписчик. Если нет, алгоритмы не порождают события вовсе.
+        [[nodiscard]] bool hasSubscribers() const noexcept
+        {
+            return !_listeners.empty();
+        }
+
+    protected:
+        /// Передать событие всем подписчикам. Вызывается только из одного потока.
+        void broadcast(Event const& event);
+
+    private:
+        std::vector<EventListener*> _listeners;
+    };
+
+}
+
+#endif//GRAVIS24_EVENT_BROADCASTER_HPP
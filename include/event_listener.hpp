@@ -2,11 +2,11 @@
 #ifndef GRAVIS24_EVENT_LISTENER_HPP
 #define GRAVIS24_EVENT_LISTENER_HPP
 
+#include "event.hpp"
 
 namespace gravis24
 {
     
-    class Event;
     class EventSource;
     
     /// "Слушатель", способный получать события.
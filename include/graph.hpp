@@ -5,21 +5,92 @@
 #include "edge_list.hpp"
 #include "dense_adjacency_matrix.hpp"
 #include "adjacency_list.hpp"
+#include "dirty_ranges.hpp"
+#include "vertex_position_arrays.hpp"
 
+#include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <future>
+#include <memory>
 
 namespace gravis24
 {
 
-    struct XYZ
+    class Graph;
+    class GraphSnapshot;
+    class ChangeableVertexPositions;
+    class ChangeableVertexPositionArrays;
+
+
+    /// Представления графа (битовая маска для Graph::prefetchViews).
+    enum class GraphViews : unsigned
+    {
+        None            = 0,
+        EdgeList        = 1u << 0,
+        AdjacencyMatrix = 1u << 1,
+        AdjacencyList   = 1u << 2,
+        All             = EdgeList | AdjacencyMatrix | AdjacencyList
+    };
+
+    [[nodiscard]] constexpr auto operator|(GraphViews a, GraphViews b) noexcept
+        -> GraphViews
     {
-        float x;
-        float y;
-        float z;
+        return static_cast<GraphViews>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    [[nodiscard]] constexpr auto operator&(GraphViews a, GraphViews b) noexcept
+        -> GraphViews
+    {
+        return static_cast<GraphViews>(static_cast<unsigned>(a) & static_cast<unsigned>(b));
+    }
+
+
+    /// Получатель уведомлений об изменении координат вершин (отрисовка, пространственные индексы).
+    class VertexPositionListener
+    {
+    public:
+        virtual ~VertexPositionListener() = default;
+
+        /// Вызывается после изменения координат (в деструкторе Changeable...), не должен бросать исключения.
+        /// @param changed изменённые вершины (упорядоченные полуинтервалы)
+        virtual void onVertexPositionsChange(Graph const& graph, DirtyRanges const& changed) = 0;
     };
 
 
+    /// Неизменяемый срез графа (одна версия): дуги и координаты вершин на момент Graph::snapshot.
+    /// Срез разделяет представления с графом; граф копирует разделяемое представление
+    /// перед первым изменением (копирование при записи), поэтому срез не меняется.
+    /// Все методы можно вызывать из нескольких потоков одновременно, в том числе во время
+    /// изменения графа; недостающие представления строятся при первом запросе (однократно).
+    class GraphSnapshot
+    {
+    public:
+        virtual ~GraphSnapshot() = default;
+
+        [[nodiscard]] virtual auto getVersion() const noexcept
+            -> uint64_t = 0;
+
+        [[nodiscard]] virtual auto getVertexCount() const noexcept
+            -> int = 0;
+        [[nodiscard]] virtual auto getArcCount() const noexcept
+            -> int = 0;
+
+        [[nodiscard]] virtual auto getEdgeListView() const
+            -> EdgeListView const& = 0;
+        [[nodiscard]] virtual auto getAdjacencyMatrixView() const
+            -> DenseAdjacencyMatrixView const& = 0;
+        [[nodiscard]] virtual auto getAdjacencyListView() const
+            -> AdjacencyListView const& = 0;
+
+        [[nodiscard]] virtual auto getVertexPositionArrays() const noexcept
+            -> VertexPositionArrays const& = 0;
+    };
+
+
+    /// Константные методы Graph можно вызывать из нескольких потоков одновременно:
+    /// недостающее представление строится один раз (остальные потоки ждут его),
+    /// разные представления -- независимо. Изменяющие методы -- только без параллельных читателей.
     class Graph
     {
     public:
@@ -53,6 +124,12 @@ namespace gravis24
 
         virtual void removeAdjacencyList() noexcept = 0;
 
+        /// @brief  Построить недостающие представления views в фоне (разные -- параллельно),
+        ///         пока вызывающий поток продолжает работу. Граф нельзя изменять до готовности.
+        /// @return готовность; деструктор future ждёт окончания построения
+        [[nodiscard]] virtual auto prefetchViews(GraphViews views = GraphViews::All) const
+            -> std::future<void> = 0;
+
 
         /// @brief  Добавить заданное число вершин (по умолчанию одну).
         /// @return индекс последней добавленной вершины
@@ -76,6 +153,7 @@ namespace gravis24
             = 0;
         
         friend class ChangeableVertexPositions;
+        friend class ChangeableVertexPositionArrays;
 
         [[nodiscard]] virtual auto getVertexPositions() const noexcept
             -> std::span<XYZ const> = 0;
@@ -83,17 +161,46 @@ namespace gravis24
         [[nodiscard]] virtual auto getVertexPositions() noexcept
             -> ChangeableVertexPositions = 0;
 
+        /// @brief Координаты вершин отдельными массивами x, y, z (выровненными для SIMD).
+        ///        Массив структур getVertexPositions строится из них по запросу.
+        [[nodiscard]] virtual auto getVertexPositionArrays() const noexcept
+            -> VertexPositionArrays const& = 0;
+
+        [[nodiscard]] virtual auto getVertexPositionArrays() noexcept
+            -> ChangeableVertexPositionArrays = 0;
+
+        /// @brief Подписаться на изменения координат вершин (повторная подписка игнорируется).
+        virtual void subscribe(VertexPositionListener& listener) = 0;
+        virtual void unsubscribe(VertexPositionListener& listener) noexcept = 0;
+
+        /// @brief Номер версии: увеличивается при каждом изменении вершин, дуг или координат.
+        [[nodiscard]] virtual auto getVersion() const noexcept
+            -> uint64_t = 0;
+
+        /// @brief Неизменяемый срез текущей версии для чтения из других потоков
+        ///        (анализ параллельно с добавлением дуг). Сам граф по-прежнему изменяется
+        ///        и читается из одного потока; снимок делается в нём же, за O(1),
+        ///        и не во время изменения координат (пока существует Changeable...).
+        [[nodiscard]] virtual auto snapshot() const
+            -> std::shared_ptr<GraphSnapshot const> = 0;
+
         // Отдельная обработка атрибутов вершин и рёбер
 
 
 
     private:
-        virtual void onVertexPositionsChange() noexcept {}
+        /// Вызывается после изменения координат; аргумент -- изменённые вершины.
+        virtual void onVertexPositionsChange(DirtyRanges const&) noexcept
+        {
+            // Пусто.
+        }
     };
 
 
     // Данный класс нужен, чтобы вызвать Graph::onVertexPositionsChange
     // после изменений значений координат вершин (в деструкторе).
+    // Изменения через set и markChanged передаются как изменённые полуинтервалы;
+    // доступ ко всему массиву (getSpan, begin, end) считается изменением всех вершин.
     class ChangeableVertexPositions
     {
     public:
@@ -121,13 +228,28 @@ namespace gravis24
             return _vertexPositions[index];
         }
 
-        [[nodiscard]] auto getSpan() const noexcept
+        void set(int index, XYZ const& position)
+        {
+            _vertexPositions[index] = position;
+            _changed.add(index);
+        }
+
+        /// @brief Отметить вершины [begin, end) как изменённые (после записи через getSpan).
+        ///        Полуинтервал обрезается до [0, size()).
+        void markChanged(int begin, int end)
         {
+            _changed.add(std::max(begin, 0), std::min(end, size()));
+        }
+
+        [[nodiscard]] auto getSpan() const
+        {
+            _changed.add(0, size());
             return _vertexPositions;
         }
 
-        [[nodiscard]] auto begin() const noexcept
+        [[nodiscard]] auto begin() const
         {
+            _changed.add(0, size());
             return _vertexPositions.begin();
         }
 
@@ -144,7 +266,8 @@ namespace gravis24
 
         ~ChangeableVertexPositions()
         {
-            _graph.onVertexPositionsChange();
+            _changed.normalize();
+            _graph.onVertexPositionsChange(_changed);
         }
 
     private:
@@ -155,8 +278,70 @@ namespace gravis24
         // Также автоматически отключает 
         // перемещающие конструктор и оператор=.
 
-        Graph&         _graph;
-        std::span<XYZ> _vertexPositions;
+        Graph&              _graph;
+        std::span<XYZ>      _vertexPositions;
+        mutable DirtyRanges _changed;
+    };
+
+
+    // То же для координат в виде структуры массивов: getArrays считается изменением всех вершин.
+    class ChangeableVertexPositionArrays
+    {
+    public:
+        ChangeableVertexPositionArrays(Graph& graph, VertexPositionArrays& vertexPositions) noexcept
+            : _graph(graph)
+            , _vertexPositions(vertexPositions)
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto size() const noexcept
+            -> int
+        {
+            return _vertexPositions.size();
+        }
+
+        void set(int index, XYZ const& position)
+        {
+            _vertexPositions.set(index, position);
+            _changed.add(index);
+        }
+
+        /// @brief Отметить вершины [begin, end) как изменённые (после записи через getArrays).
+        ///        Полуинтервал обрезается до [0, size()).
+        void markChanged(int begin, int end)
+        {
+            _changed.add(std::max(begin, 0), std::min(end, size()));
+        }
+
+        [[nodiscard]] auto getArrays() const
+            -> VertexPositionArrays&
+        {
+            _changed.add(0, size());
+            return _vertexPositions;
+        }
+
+        [[nodiscard]] auto getGraph() const noexcept
+            -> Graph&
+        {
+            return _graph;
+        }
+
+        ~ChangeableVertexPositionArrays()
+        {
+            _changed.normalize();
+            _graph.onVertexPositionsChange(_changed);
+        }
+
+    private:
+        ChangeableVertexPositionArrays(ChangeableVertexPositionArrays const&)
+            = delete;
+        auto operator=(ChangeableVertexPositionArrays const&)
+            -> ChangeableVertexPositionArrays& = delete;
+
+        Graph&                _graph;
+        VertexPositionArrays& _vertexPositions;
+        mutable DirtyRanges   _changed;
     };
 
 
@@ -164,6 +349,12 @@ namespace gravis24
     [[nodiscard]] auto newGraph(int vertexCount = 0)
         -> std::unique_ptr<Graph>;
 
+    /// @brief             Создать представление графа по умолчанию на готовом списке дуг
+    ///                    (вместе с его атрибутами; дуги не проверяются на повторы).
+    /// @param vertexCount количество вершин, не меньше наибольшего номера вершины в el плюс 1
+    [[nodiscard]] auto newGraph(std::unique_ptr<EditableEdgeList> el, int vertexCount)
+        -> std::unique_ptr<Graph>;
+
 }
 
 #endif//GRAVIS24_GRAPH_HPP
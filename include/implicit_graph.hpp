@@ -0,0 +1,83 @@
+/// @file implicit_graph.hpp
+/// @brief Неявные (порождаемые) графы: решётки, тор, полный граф, гиперкуб, циркулянт.
+///
+/// Дуги таких графов не хранятся, а вычисляются по номеру вершины,
+/// поэтому память на граф не зависит (кроме полного графа) от числа вершин.
+/// Все графы неориентированные: каждое ребро представлено парой встречных дуг.
+/// Атрибутов у вершин и дуг нет.
+#ifndef GRAVIS24_IMPLICIT_GRAPH_HPP
+#define GRAVIS24_IMPLICIT_GRAPH_HPP
+
+#include "adjacency_list.hpp"
+
+#include <span>
+#include <memory>
+
+namespace gravis24
+{
+
+    ///////////////////////////////////////////////////////
+    // Интерфейс ImplicitGraphView
+
+    class ImplicitGraphView
+        : public AdjacencyListView
+    {
+    public:
+        /// @brief Наибольшая степень выхода вершины (достаточный размер буфера для copyTargets).
+        [[nodiscard]] virtual auto getMaxTargetCount() const noexcept
+            -> int = 0;
+
+        /// @brief        Записать окрестность вершины в буфер, предоставленный вызывающим.
+        ///               В отличие от getTargets безопасно при вложенных вызовах и
+        ///               при обращении из нескольких потоков с разными буферами.
+        /// @param vertex номер вершины
+        /// @param buffer буфер размером не менее getMaxTargetCount()
+        /// @return       количество записанных вершин (0 при неверном индексе или малом буфере)
+        [[nodiscard]] virtual auto copyTargets(int vertex, std::span<int> buffer) const noexcept
+            -> int = 0;
+
+        // Замечание о getTargets: окрестность вычисляется в буфер,
+        // принадлежащий потоку (thread_local), поэтому возвращаемый span
+        // действителен только до следующего вызова getTargets в этом же потоке.
+        // Исключение: полный граф, у которого окрестности не вычисляются.
+    };
+
+
+    //////////////////////////////////////////////////
+    // Функции для создания неявных графов.
+    // При недопустимых параметрах (в том числе при
+    // переполнении int числом вершин) возвращают nullptr.
+
+    /// @brief Прямоугольная решётка width x height, вершина (x, y) имеет номер x + width * y.
+    [[nodiscard]] auto newGrid2DGraph(int width, int height)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+    /// @brief Решётка на торе (с замыканием по обеим осям).
+    [[nodiscard]] auto newTorus2DGraph(int width, int height)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+    /// @brief Трёхмерная решётка, вершина (x, y, z) имеет номер x + width * (y + height * z).
+    [[nodiscard]] auto newGrid3DGraph(int width, int height, int depth)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+    /// @brief Трёхмерная решётка с замыканием по всем трём осям.
+    [[nodiscard]] auto newTorus3DGraph(int width, int height, int depth)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+    /// @brief Полный граф без петель. Хранит 2 * vertexCount целых,
+    ///        чтобы getTargets возвращал окрестности без вычислений.
+    [[nodiscard]] auto newCompleteGraph(int vertexCount)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+    /// @brief Гиперкуб размерности dimension (< 31): вершины соединены, если различаются одним битом.
+    [[nodiscard]] auto newHypercubeGraph(int dimension)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+    /// @brief         Циркулянтный граф: v соединена с (v +- d) mod vertexCount для всех d из offsets.
+    /// @param offsets сдвиги (допускаются отрицательные и повторяющиеся; сдвиги, кратные vertexCount, игнорируются)
+    [[nodiscard]] auto newCirculantGraph(int vertexCount, std::span<int const> offsets)
+        -> std::unique_ptr<ImplicitGraphView>;
+
+}
+
+#endif//GRAVIS24_IMPLICIT_GRAPH_HPP
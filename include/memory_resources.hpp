@@ -0,0 +1,115 @@
+/// @file memory_resources.hpp
+/// @brief Источники памяти (std::pmr::memory_resource) для контейнеров графа:
+///        монотонная арена и выделение больших блоков на страницах по 2 МБ.
+///
+/// Контейнер, созданный с источником (newAdjacencyListVector(vertexCount, resource) и т.п.),
+/// берёт из него всю память под данные. Источник должен жить дольше контейнера.
+#ifndef GRAVIS24_MEMORY_RESOURCES_HPP
+#define GRAVIS24_MEMORY_RESOURCES_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace gravis24
+{
+
+    /// Монотонная арена: выделение -- сдвиг указателя в текущем блоке, освобождение отдельных
+    /// участков ничего не делает, release() возвращает все блоки сразу за O(число блоков).
+    /// Удобна для временных графов одного запроса: контейнеры уничтожаются, затем арена
+    /// освобождается целиком. Не потокобезопасна.
+    class MonotonicArena
+        : public std::pmr::memory_resource
+    {
+    public:
+        /// @param initialBlockSize размер первого блока; следующие вдвое больше предыдущего
+        /// @param upstream         источник блоков
+        explicit MonotonicArena(
+                size_t                      initialBlockSize = 64 * 1024,
+                std::pmr::memory_resource*  upstream         = std::pmr::get_default_resource()
+            ) noexcept;
+
+        ~MonotonicArena() override;
+
+        MonotonicArena(MonotonicArena const&) = delete;
+        auto operator=(MonotonicArena const&)
+            -> MonotonicArena& = delete;
+
+        /// @brief Вернуть все блоки источнику; память всех выделенных участков становится недействительной.
+        void release() noexcept;
+
+        /// @brief Сколько байт выделено участками (с учётом выравнивания) с последнего release.
+        [[nodiscard]] auto getAllocatedBytes() const noexcept
+            -> size_t
+        {
+            return _allocatedBytes;
+        }
+
+        /// @brief Сколько байт взято у источника блоками.
+        [[nodiscard]] auto getReservedBytes() const noexcept
+            -> size_t
+        {
+            return _reservedBytes;
+        }
+
+    private:
+        struct Block;
+
+        std::pmr::memory_resource* _upstream;
+        Block*                     _blocks         = nullptr;
+        std::byte*                 _current        = nullptr;
+        std::byte*                 _end            = nullptr;
+        size_t                     _nextBlockSize;
+        size_t                     _allocatedBytes = 0;
+        size_t                     _reservedBytes  = 0;
+
+        auto do_allocate(size_t bytes, size_t alignment)
+            -> void* override;
+
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) noexcept override;
+
+        [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+
+    /// Блоки от threshold байт выделяются отдельно, с выравниванием и размером, кратными 2 МБ,
+    /// и помечаются для прозрачных больших страниц (Linux: mmap + madvise(MADV_HUGEPAGE)),
+    /// что уменьшает промахи TLB при обходе больших битовых матриц и массивов дуг.
+    /// Меньшие блоки и все блоки на других системах берутся у upstream. Потокобезопасен,
+    /// если потокобезопасен upstream.
+    class HugePageResource
+        : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t hugePageSize = size_t{2} << 20;
+
+        explicit HugePageResource(
+                size_t                      threshold = hugePageSize / 2,
+                std::pmr::memory_resource*  upstream  = std::pmr::get_default_resource()
+            ) noexcept
+            : _upstream(upstream)
+            , _threshold(threshold)
+        {
+            // Пусто.
+        }
+
+    private:
+        std::pmr::memory_resource* _upstream;
+        size_t                     _threshold;
+
+        auto do_allocate(size_t bytes, size_t alignment)
+            -> void* override;
+
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) noexcept override;
+
+        [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+}
+
+#endif//GRAVIS24_MEMORY_RESOURCES_HPP
@@ -0,0 +1,132 @@
+/// @file parallel.hpp
+/// @brief Простейшие средства распараллеливания циклов на std::jthread.
+#ifndef GRAVIS24_PARALLEL_HPP
+#define GRAVIS24_PARALLEL_HPP
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
+
+namespace gravis24
+{
+
+    /// @brief Число рабочих потоков, используемое параллельными алгоритмами (не меньше 1).
+    [[nodiscard]] inline auto getWorkerCount() noexcept
+        -> int
+    {
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+
+    template <typename F>
+    concept BlockFunction =
+        std::is_invocable_v<F, int, int, int>;
+
+
+    /// @brief       Выполнить body(worker, begin, end) для блоков [begin, end), покрывающих [0, count).
+    ///              Блоки раздаются потокам динамически (по мере освобождения),
+    ///              worker < getWorkerCount() -- номер потока для доступа к его локальным буферам.
+    ///              При малом count всё выполняется в вызывающем потоке (worker == 0).
+    /// @param grain размер блока
+    template <BlockFunction Body>
+    void parallelForBlocks(int count, int grain, Body body)
+    {
+        if (count <= 0)
+            return;
+
+        grain = std::max(grain, 1);
+        auto const blockCount  = (count - 1) / grain + 1;
+        auto const workerCount = std::min(getWorkerCount(), blockCount);
+        if (workerCount == 1)
+        {
+            body(0, 0, count);
+            return;
+        }
+
+        std::atomic<int> nextBlock {0};
+        auto work = [&](int worker)
+            {
+                for (int block = nextBlock++; block < blockCount; block = nextBlock++)
+                {
+                    auto const begin = block * grain;
+                    body(worker, begin, std::min(count, begin + grain));
+                }
+            };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(static_cast<size_t>(workerCount - 1));
+            for (int worker = 1; worker < workerCount; ++worker)
+                threads.emplace_back(work, worker);
+
+            work(0);
+        } // jthread ожидает завершения в деструкторе.
+    }
+
+
+    /// @brief Псевдослучайный приоритет элемента index (splitmix64): зависит только от seed и index,
+    ///        поэтому потоки без синхронизации согласованно разрешают конфликты между соседями.
+    [[nodiscard]] constexpr auto getPriority(uint64_t seed, int index) noexcept
+        -> uint64_t
+    {
+        auto z = seed + (static_cast<uint64_t>(index) + 1) * 0x9E37'79B9'7F4A'7C15u;
+        z = (z ^ (z >> 30)) * 0xBF58'476D'1CE5'E9B9u;
+        z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EBu;
+        return z ^ (z >> 31);
+    }
+
+
+    /// @brief Сортировка: части диапазона сортируются параллельно,
+    ///        затем попарно сливаются (слияния одного уровня -- тоже параллельно).
+    ///        Не устойчива; небольшие диапазоны сортируются std::sort.
+    template <std::random_access_iterator It, typename Compare = std::ranges::less>
+    void parallelSort(It first, It last, Compare compare = {})
+    {
+        // Меньшие части не окупают запуск потоков.
+        constexpr std::ptrdiff_t minChunk = 1 << 14;
+
+        auto const count      = static_cast<std::ptrdiff_t>(last - first);
+        auto const chunkCount = static_cast<int>(std::min<std::ptrdiff_t>(getWorkerCount(), count / minChunk));
+        if (chunkCount <= 1)
+        {
+            std::sort(first, last, compare);
+            return;
+        }
+
+        std::vector<std::ptrdiff_t> bounds(static_cast<size_t>(chunkCount) + 1);
+        for (int c = 0; c <= chunkCount; ++c)
+            bounds[c] = static_cast<std::ptrdiff_t>(static_cast<int64_t>(count) * c / chunkCount);
+
+        parallelForBlocks(chunkCount, 1,
+            [&](int, int begin, int end)
+            {
+                for (int c = begin; c < end; ++c)
+                    std::sort(first + bounds[c], first + bounds[c + 1], compare);
+            });
+
+        for (int width = 1; width < chunkCount; width *= 2)
+        {
+            auto const pairCount = (chunkCount - 1) / (2 * width) + 1;
+            parallelForBlocks(pairCount, 1,
+                [&](int, int begin, int end)
+                {
+                    for (int p = begin; p < end; ++p)
+                    {
+                        auto const low  = 2 * width * p;
+                        auto const mid  = std::min(low + width, chunkCount);
+                        auto const high = std::min(low + 2 * width, chunkCount);
+                        if (mid < high)
+                            std::inplace_merge(first + bounds[low], first + bounds[mid], first + bounds[high], compare);
+                    }
+                });
+        }
+    }
+
+}
+
+#endif//GRAVIS24_PARALLEL_HPP
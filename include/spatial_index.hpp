@@ -0,0 +1,395 @@
+/// @file spatial_index.hpp
+/// @brief Пространственный индекс по координатам вершин (и дуг): иерархия ограничивающих
+///        параллелепипедов по кривой Мортона для выбора ближайшей вершины/дуги и запросов в области.
+#ifndef GRAVIS24_SPATIAL_INDEX_HPP
+#define GRAVIS24_SPATIAL_INDEX_HPP
+
+#include "graph.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace gravis24
+{
+
+    /// Пустой параллелепипед: объединение с ним ничего не меняет, расстояние до него бесконечно.
+    [[nodiscard]] constexpr auto getEmptyBox() noexcept
+        -> Box
+    {
+        constexpr auto inf = std::numeric_limits<float>::infinity();
+        return { { inf, inf, inf }, { -inf, -inf, -inf } };
+    }
+
+    [[nodiscard]] constexpr auto unite(Box const& a, Box const& b) noexcept
+        -> Box
+    {
+        return {
+            { std::min(a.low.x, b.low.x), std::min(a.low.y, b.low.y), std::min(a.low.z, b.low.z) },
+            { std::max(a.high.x, b.high.x), std::max(a.high.y, b.high.y), std::max(a.high.z, b.high.z) }
+        };
+    }
+
+    [[nodiscard]] constexpr bool intersect(Box const& a, Box const& b) noexcept
+    {
+        return a.low.x <= b.high.x && b.low.x <= a.high.x
+            && a.low.y <= b.high.y && b.low.y <= a.high.y
+            && a.low.z <= b.high.z && b.low.z <= a.high.z;
+    }
+
+    /// Квадрат расстояния от точки до параллелепипеда (0 внутри).
+    [[nodiscard]] constexpr auto getDistance2(XYZ const& p, Box const& box) noexcept
+        -> float
+    {
+        auto const dx = std::max({ box.low.x - p.x, 0.f, p.x - box.high.x });
+        auto const dy = std::max({ box.low.y - p.y, 0.f, p.y - box.high.y });
+        auto const dz = std::max({ box.low.z - p.z, 0.f, p.z - box.high.z });
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+
+    /// Иерархия параллелепипедов над набором элементов (LBVH): элементы упорядочены по коду Мортона
+    /// центров, листья -- подряд идущие группы по leafSize элементов, внутренние узлы образуют
+    /// полное двоичное дерево в массиве (корень 1, дети узла i -- 2i и 2i + 1).
+    /// Порядок не пересчитывается при refit, поэтому после больших перемещений лучше перестроить.
+    class BoxHierarchy
+    {
+    public:
+        static constexpr int leafSize = 8;
+
+        /// @brief        Построить: коды Мортона и параллелепипеды листьев -- параллельно, сортировка -- parallelSort.
+        /// @param getBox Box(int item), вызывается из нескольких потоков
+        template <typename GetBox>
+        void build(int count, GetBox getBox);
+
+        /// @brief Обновить параллелепипеды элементов items и их предков: O(|items| log count).
+        template <typename GetBox>
+        void refit(std::span<int const> items, GetBox getBox);
+
+        [[nodiscard]] auto getCount() const noexcept
+            -> int
+        {
+            return static_cast<int>(_items.size());
+        }
+
+        [[nodiscard]] auto getItemBox(int item) const noexcept
+            -> Box const&
+        {
+            return _itemBoxes[_slots[item]];
+        }
+
+        /// @brief       Обойти элементы, параллелепипеды которых (и их предков) принимает enter.
+        /// @param enter bool(Box const&)
+        /// @param visit void(int item, Box const&)
+        template <typename Enter, typename Visit>
+        void traverse(Enter enter, Visit visit) const;
+
+        /// @brief                Ближайший элемент: поиск в глубину, ближний ребёнок первым,
+        ///                       поддеревья дальше найденного отсекаются.
+        /// @param itemDistance2  float(int item, Box const&) -- квадрат расстояния до элемента
+        /// @param maxDistance2   элементы строго ближе этого
+        /// @return               -1, если такого элемента нет
+        template <typename ItemDistance2>
+        [[nodiscard]] auto findNearest(XYZ const& point, ItemDistance2 itemDistance2, float maxDistance2) const
+            -> int;
+
+    private:
+        std::vector<int> _items;     // элемент по позиции (в порядке Мортона)
+        std::vector<int> _slots;     // позиция по элементу
+        std::vector<Box> _itemBoxes; // по позиции
+        std::vector<Box> _nodes;     // узлы дерева, листья -- с _firstLeaf
+        int              _firstLeaf = 1;
+
+        void _uniteLeaf(int leaf) noexcept;
+    };
+
+
+    /// Индекс по вершинам и (необязательно) дугам графа.
+    /// Подписанный на граф (Graph::subscribe) индекс сам обновляется при изменении координат.
+    class SpatialIndex
+        : public VertexPositionListener
+    {
+    public:
+        /// @brief Построить только по вершинам.
+        void build(VertexPositionArrays const& positions);
+
+        /// @brief Построить по вершинам и дугам el (номер дуги -- как в el.getArcs()).
+        void build(VertexPositionArrays const& positions, EdgeListView const& el);
+
+        void build(Graph const& graph, bool withArcs = true);
+
+        /// @brief Обновить индекс после изменения координат вершин changed (и инцидентных им дуг).
+        ///        Если изменилось число вершин, индекс строится заново (дуги -- по сохранённым концам).
+        void refit(VertexPositionArrays const& positions, DirtyRanges const& changed);
+
+        void onVertexPositionsChange(Graph const& graph, DirtyRanges const& changed) override;
+
+        /// @return -1, если вершин нет ближе maxDistance
+        [[nodiscard]] auto findNearestVertex(
+                XYZ const& point,
+                float      maxDistance = std::numeric_limits<float>::infinity()
+            ) const -> int;
+
+        /// @return номер ближайшей (по расстоянию до отрезка) дуги или -1
+        [[nodiscard]] auto findNearestArc(
+                XYZ const& point,
+                float      maxDistance = std::numeric_limits<float>::infinity()
+            ) const -> int;
+
+        /// @return вершины внутри box (включая границу) в порядке Мортона
+        [[nodiscard]] auto findVerticesInBox(Box const& box) const
+            -> std::vector<int>;
+
+        [[nodiscard]] auto findVerticesInSphere(XYZ const& center, float radius) const
+            -> std::vector<int>;
+
+    private:
+        BoxHierarchy     _vertices;
+        BoxHierarchy     _arcs;
+        std::vector<Arc> _arcEnds;
+        /// Дуги, инцидентные вершине (CSR), для обновления дуг при refit.
+        std::vector<int> _incidenceOffsets;
+        std::vector<int> _incidentArcs;
+
+        [[nodiscard]] auto _getPosition(int vertex) const noexcept
+            -> XYZ const&
+        {
+            return _vertices.getItemBox(vertex).low;
+        }
+
+        [[nodiscard]] auto _getArcBox(int arc) const noexcept
+            -> Box;
+
+        void _buildArcs();
+    };
+
+
+    namespace detail
+    {
+
+        /// 10 младших битов value, разнесённые через два.
+        [[nodiscard]] constexpr auto spreadBits(uint32_t value) noexcept
+            -> uint32_t
+        {
+            value &= 0x3ff;
+            value = (value | (value << 16)) & 0x030000FF;
+            value = (value | (value << 8))  & 0x0300F00F;
+            value = (value | (value << 4))  & 0x030C30C3;
+            value = (value | (value << 2))  & 0x09249249;
+            return value;
+        }
+
+    }
+
+
+    template <typename GetBox>
+    void BoxHierarchy::build(int count, GetBox getBox)
+    {
+        count = std::max(count, 0);
+        std::vector<Box> boxes(static_cast<size_t>(count));
+        std::vector<Box> boundsByWorker(static_cast<size_t>(getWorkerCount()), getEmptyBox());
+        parallelForBlocks(count, 4096,
+            [&](int worker, int begin, int end)
+            {
+                auto& bounds = boundsByWorker[worker];
+                for (int i = begin; i < end; ++i)
+                {
+                    boxes[i] = getBox(i);
+                    bounds   = unite(bounds, boxes[i]);
+                }
+            });
+
+        auto scene = getEmptyBox();
+        for (auto const& bounds: boundsByWorker)
+            scene = unite(scene, bounds);
+
+        // Ключ: код Мортона центра (30 бит) и номер элемента -- порядок однозначен.
+        auto const scale = [&scene](float low, float high) noexcept
+            {
+                return high > low? 1023.f / (high - low): 0.f;
+            };
+        auto const sx = scale(scene.low.x, scene.high.x);
+        auto const sy = scale(scene.low.y, scene.high.y);
+        auto const sz = scale(scene.low.z, scene.high.z);
+        std::vector<uint64_t> keys(static_cast<size_t>(count));
+        parallelForBlocks(count, 4096,
+            [&](int, int begin, int end)
+            {
+                for (int i = begin; i < end; ++i)
+                {
+                    auto const& box = boxes[i];
+                    uint32_t code = 0;
+                    if (box.low.x <= box.high.x)
+                    {
+                        auto const cell = [](float value) noexcept
+                            {
+                                return static_cast<uint32_t>(std::clamp(value, 0.f, 1023.f));
+                            };
+                        code = detail::spreadBits(cell(((box.low.x + box.high.x) / 2.f - scene.low.x) * sx))
+                             | detail::spreadBits(cell(((box.low.y + box.high.y) / 2.f - scene.low.y) * sy)) << 1
+                             | detail::spreadBits(cell(((box.low.z + box.high.z) / 2.f - scene.low.z) * sz)) << 2;
+                    }
+
+                    keys[i] = static_cast<uint64_t>(code) << 32 | static_cast<uint32_t>(i);
+                }
+            });
+        parallelSort(keys.begin(), keys.end());
+
+        _items.resize(static_cast<size_t>(count));
+        _slots.resize(static_cast<size_t>(count));
+        _itemBoxes.resize(static_cast<size_t>(count));
+        parallelForBlocks(count, 4096,
+            [&](int, int begin, int end)
+            {
+                for (int slot = begin; slot < end; ++slot)
+                {
+                    auto const item = static_cast<int>(keys[slot] & 0xFFFF'FFFFu);
+                    _items[slot]     = item;
+                    _slots[item]     = slot;
+                    _itemBoxes[slot] = boxes[item];
+                }
+            });
+
+        auto const leafCount = std::max((count + leafSize - 1) / leafSize, 1);
+        _firstLeaf = static_cast<int>(std::bit_ceil(static_cast<unsigned>(leafCount)));
+        _nodes.assign(2 * static_cast<size_t>(_firstLeaf), getEmptyBox());
+        parallelForBlocks(leafCount, 1024,
+            [this](int, int begin, int end)
+            {
+                for (int leaf = begin; leaf < end; ++leaf)
+                    _uniteLeaf(leaf);
+            });
+
+        for (int level = _firstLeaf / 2; level >= 1; level /= 2)
+        {
+            parallelForBlocks(level, 4096,
+                [this, level](int, int begin, int end)
+                {
+                    for (int i = level + begin; i < level + end; ++i)
+                        _nodes[i] = unite(_nodes[2 * i], _nodes[2 * i + 1]);
+                });
+        }
+    }
+
+
+    template <typename GetBox>
+    void BoxHierarchy::refit(std::span<int const> items, GetBox getBox)
+    {
+        std::vector<int> nodes;
+        nodes.reserve(items.size());
+        for (int const item: items)
+        {
+            auto const slot = _slots[item];
+            _itemBoxes[slot] = getBox(item);
+            nodes.push_back(_firstLeaf + slot / leafSize);
+        }
+
+        std::ranges::sort(nodes);
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        for (int const node: nodes)
+            _uniteLeaf(node - _firstLeaf);
+
+        // Предки -- по уровням, каждый узел пересчитывается один раз.
+        while (!nodes.empty() && nodes.front() > 1)
+        {
+            for (int& node: nodes)
+                node /= 2;
+            nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+            for (int const node: nodes)
+                _nodes[node] = unite(_nodes[2 * node], _nodes[2 * node + 1]);
+        }
+    }
+
+
+    template <typename Enter, typename Visit>
+    void BoxHierarchy::traverse(Enter enter, Visit visit) const
+    {
+        if (_items.empty())
+            return;
+
+        std::array<int, 64> stack;
+        int top = 0;
+        stack[top++] = 1;
+        while (top > 0)
+        {
+            auto const node = stack[--top];
+            if (!enter(_nodes[node]))
+                continue;
+
+            if (node < _firstLeaf)
+            {
+                stack[top++] = 2 * node + 1;
+                stack[top++] = 2 * node;
+                continue;
+            }
+
+            auto const begin = (node - _firstLeaf) * leafSize;
+            auto const end   = std::min(begin + leafSize, getCount());
+            for (int slot = begin; slot < end; ++slot)
+                if (enter(_itemBoxes[slot]))
+                    visit(_items[slot], _itemBoxes[slot]);
+        }
+    }
+
+
+    template <typename ItemDistance2>
+    auto BoxHierarchy::findNearest(XYZ const& point, ItemDistance2 itemDistance2, float maxDistance2) const
+        -> int
+    {
+        int  best         = -1;
+        auto bestDistance = maxDistance2;
+        if (_items.empty())
+            return best;
+
+        std::array<int, 64> stack;
+        int top = 0;
+        stack[top++] = 1;
+        while (top > 0)
+        {
+            auto const node = stack[--top];
+            if (getDistance2(point, _nodes[node]) > bestDistance)
+                continue;
+
+            if (node < _firstLeaf)
+            {
+                auto const near = 2 * node, far = 2 * node + 1;
+                if (getDistance2(point, _nodes[near]) <= getDistance2(point, _nodes[far]))
+                {
+                    stack[top++] = far;
+                    stack[top++] = near;
+                }
+                else
+                {
+                    stack[top++] = near;
+                    stack[top++] = far;
+                }
+                continue;
+            }
+
+            auto const begin = (node - _firstLeaf) * leafSize;
+            auto const end   = std::min(begin + leafSize, getCount());
+            for (int slot = begin; slot < end; ++slot)
+            {
+                if (getDistance2(point, _itemBoxes[slot]) > bestDistance)
+                    continue;
+
+                auto const distance = itemDistance2(_items[slot], _itemBoxes[slot]);
+                if (distance < bestDistance)
+                {
+                    best         = _items[slot];
+                    bestDistance = distance;
+                }
+            }
+        }
+
+        return best;
+    }
+
+}
+
+#endif//GRAVIS24_SPATIAL_INDEX_HPP
@@ -0,0 +1,172 @@
+/// @file vertex_position_arrays.hpp
+#ifndef GRAVIS24_VERTEX_POSITION_ARRAYS_HPP
+#define GRAVIS24_VERTEX_POSITION_ARRAYS_HPP
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace gravis24
+{
+
+    struct XYZ
+    {
+        float x;
+        float y;
+        float z;
+    };
+
+
+    /// Ограничивающий параллелепипед со сторонами, параллельными осям.
+    struct Box
+    {
+        XYZ low;
+        XYZ high;
+    };
+
+
+    /// Аллокатор, выравнивающий начало массива по границе Alignment байт.
+    template <typename T, size_t Alignment>
+    class AlignedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto allocate(size_t count)
+            -> T*
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+        }
+
+        void deallocate(T* pointer, size_t) noexcept
+        {
+            ::operator delete(pointer, std::align_val_t{ Alignment });
+        }
+
+        template <typename U>
+        [[nodiscard]] bool operator==(AlignedAllocator<U, Alignment> const&) const noexcept
+        {
+            return true;
+        }
+    };
+
+
+    /// Координаты вершин "структурой массивов": отдельные массивы x, y, z,
+    /// каждый выровнен по 32 байтам (регистр AVX), поэтому циклы по вершинам
+    /// (силы укладки, ограничивающий параллелепипед, отсечение) векторизуются на полную ширину.
+    class VertexPositionArrays
+    {
+    public:
+        static constexpr size_t alignment = 32;
+
+        VertexPositionArrays() noexcept = default;
+
+        explicit VertexPositionArrays(int count)
+        {
+            resize(count);
+        }
+
+        [[nodiscard]] auto size() const noexcept
+            -> int
+        {
+            return static_cast<int>(_x.size());
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _x.empty();
+        }
+
+        /// @brief Изменить число вершин; координаты новых вершин нулевые.
+        void resize(int count)
+        {
+            _x.resize(static_cast<size_t>(count));
+            _y.resize(static_cast<size_t>(count));
+            _z.resize(static_cast<size_t>(count));
+        }
+
+        [[nodiscard]] auto getX() noexcept
+            -> std::span<float>
+        {
+            return _x;
+        }
+
+        [[nodiscard]] auto getY() noexcept
+            -> std::span<float>
+        {
+            return _y;
+        }
+
+        [[nodiscard]] auto getZ() noexcept
+            -> std::span<float>
+        {
+            return _z;
+        }
+
+        [[nodiscard]] auto getX() const noexcept
+            -> std::span<float const>
+        {
+            return _x;
+        }
+
+        [[nodiscard]] auto getY() const noexcept
+            -> std::span<float const>
+        {
+            return _y;
+        }
+
+        [[nodiscard]] auto getZ() const noexcept
+            -> std::span<float const>
+        {
+            return _z;
+        }
+
+        [[nodiscard]] auto get(int vertex) const noexcept
+            -> XYZ
+        {
+            return { _x[vertex], _y[vertex], _z[vertex] };
+        }
+
+        void set(int vertex, XYZ const& position) noexcept
+        {
+            _x[vertex] = position.x;
+            _y[vertex] = position.y;
+            _z[vertex] = position.z;
+        }
+
+        /// @brief Скопировать в массив структур (размер должен совпадать).
+        void copyTo(std::span<XYZ> positions) const noexcept;
+
+        /// @brief Скопировать из массива структур (размер должен совпадать).
+        void copyFrom(std::span<XYZ const> positions) noexcept;
+
+        /// @brief Ограничивающий параллелепипед; для пустого набора -- нулевой.
+        [[nodiscard]] auto getBounds() const noexcept
+            -> Box;
+
+    private:
+        using Floats = std::vector<float, AlignedAllocator<float, alignment>>;
+
+        Floats _x;
+        Floats _y;
+        Floats _z;
+    };
+
+}
+
+#endif//GRAVIS24_VERTEX_POSITION_ARRAYS_HPP
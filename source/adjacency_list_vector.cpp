@@ -1,10 +1,14 @@
 ﻿/// @file  adjacency_list_vector.cpp
-/// @brief Реализация EditableAdjacencyList поверх vector vector int.
+/// @brief Реализация EditableAdjacencyList поверх вектора вершин с малым встроенным массивом целей.
 #include "../include/adjacency_list.hpp"
 
 #include <vector>
+#include <span>
 #include <iterator>
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
 
 namespace gravis24
 {
@@ -13,235 +17,491 @@ namespace gravis24
     namespace
     {
 
-        // Объединяет в себе наборы типизированных атрибутов
-        class AttributesBase
+        // Число дуг, цели которых хранятся прямо в Vertex. Большинство вершин реальных
+        // графов имеет малую степень: их цели лежат рядом с вершиной, без отдельного блока в куче.
+        constexpr int inlineTargetCount = 6;
+
+        // С какой ёмкости блока целей к нему добавляется хеш-индекс "цель -> номер дуги":
+        // areConnected и getArc у вершин-хабов (10^5 и более соседей) работают за O(1),
+        // а малые вершины обходятся линейным поиском по нескольким целям.
+        constexpr int indexedTargetCount = 32;
+
+
+        // Число ячеек хеш-индекса для блока целей ёмкости capacity: степень двойки не меньше
+        // 2 * capacity (заполнение не больше половины), 0 -- индекса нет.
+        [[nodiscard]] auto getIndexSlotCount(int capacity) noexcept
+            -> int
+        {
+            return capacity < indexedTargetCount? 0: 2 * static_cast<int>(std::bit_ceil(static_cast<unsigned>(capacity)));
+        }
+
+
+        // Атрибуты вершины и её дуг. Атрибуты дуги i -- отрезки
+        // [i * arcIntStride, (i + 1) * arcIntStride) в arcInts и так же в arcFloats.
+        struct Attributes
         {
-        protected:
-            ~AttributesBase() noexcept = default;
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            std::pmr::vector<int>   ints;
+            std::pmr::vector<float> floats;
+            std::pmr::vector<int>   arcInts;
+            std::pmr::vector<float> arcFloats;
+            int                     arcIntStride   = 0;
+            int                     arcFloatStride = 0;
+
+            explicit Attributes(allocator_type const& allocator) noexcept
+                : ints(allocator)
+                , floats(allocator)
+                , arcInts(allocator)
+                , arcFloats(allocator)
+            {
+                // Пусто.
+            }
+
+            Attributes(Attributes const& other, allocator_type const& allocator)
+                : ints(other.ints, allocator)
+                , floats(other.floats, allocator)
+                , arcInts(other.arcInts, allocator)
+                , arcFloats(other.arcFloats, allocator)
+                , arcIntStride(other.arcIntStride)
+                , arcFloatStride(other.arcFloatStride)
+            {
+                // Пусто.
+            }
+        };
+
+
+        // Сменить число атрибутов у каждой из count дуг, сохранив общие значения.
+        template <typename AttrType>
+        void restride(std::pmr::vector<AttrType>& attrs, int& stride, int newStride, int count)
+        {
+            if (stride == newStride)
+                return;
+
+            std::pmr::vector<AttrType> result(
+                    static_cast<size_t>(count) * static_cast<size_t>(newStride),
+                    attrs.get_allocator()
+                );
+
+            auto const common = std::min(stride, newStride);
+            for (int i = 0; i < count; ++i)
+            {
+                std::copy_n(
+                        attrs.begin() + static_cast<ptrdiff_t>(i) * stride,
+                        common,
+                        result.begin() + static_cast<ptrdiff_t>(i) * newStride
+                    );
+            }
+
+            attrs  = std::move(result);
+            stride = newStride;
+        }
+
 
+        // Вершина занимает 48 байт: источник памяти, размер и ёмкость массива целей,
+        // сами цели (до inlineTargetCount) или указатель на блок в куче и указатель на атрибуты.
+        // Блок целей растёт вдвое; атрибуты создаются, только когда они есть.
+        // Блок целей ёмкости от indexedTargetCount продолжается хеш-индексом с открытой адресацией
+        // (линейное пробирование): ячейка хранит номер дуги или -1; индекс перестраивается вместе с блоком.
+        // Инварианты:
+        // _targetCount <= _targetCapacity; _targetCapacity > inlineTargetCount <=> цели в _heapTargets;
+        // _attributes->arcInts.size() == _targetCount * _attributes->arcIntStride (так же для float)
+        // -- у каждой вершины одинаковое число атрибутов.
+        class Vertex
+        {
         public:
-            void resizeIntAttrs(int count)
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            Vertex() noexcept = default;
+
+            explicit Vertex(allocator_type const& allocator) noexcept
+                : _allocator(allocator)
             {
-                _intAttrs.resize(static_cast<size_t>(count));
+                // Пусто.
             }
 
-            void reserveIntAttrs(int capacity)
+            Vertex(Vertex const& other, allocator_type const& allocator)
+                : _allocator(allocator)
             {
-                _intAttrs.reserve(capacity);
+                _copy(other);
             }
 
-            void resizeFloatAttrs(int count)
+            Vertex(Vertex&& other, allocator_type const& allocator)
+                : _allocator(allocator)
             {
-                _floatAttrs.resize(count);
+                if (_allocator == other._allocator)
+                    _steal(other);
+                else
+                    _copy(other);
+            }
+
+            Vertex(Vertex&& other) noexcept
+                : _allocator(other._allocator)
+            {
+                _steal(other);
             }
 
-            void reserveFloatAttrs(int capacity)
+            Vertex(Vertex const&) = delete;
+            auto operator=(Vertex const&)
+                -> Vertex& = delete;
+
+            ~Vertex()
             {
-                _floatAttrs.reserve(capacity);
+                _releaseTargets();
+                if (_attributes)
+                    _allocator.delete_object(_attributes);
             }
 
-            template <typename AttrType>
-            void resizeAttrs(int count)
+            // Добавить дугу в конец, вернуть её номер.
+            auto addArc(int target, int arcIntAttrCount, int arcFloatAttrCount)
+                -> int
             {
-                if constexpr (std::is_same_v<AttrType, int>)
+                auto const arc   = _targetCount;
+                auto const count = arc + 1;
+                if (count > _targetCapacity)
+                    _reallocateTargets(std::max(count, 2 * _targetCapacity));
+
+                _getTargetData()[arc] = target;
+                _targetCount = count;
+                if (_isIndexed())
+                    _indexArc(arc);
+
+                if (_attributes || arcIntAttrCount > 0 || arcFloatAttrCount > 0)
                 {
-                    resizeIntAttrs(count);
+                    auto& attrs = _getAttributes();
+                    attrs.arcIntStride   = arcIntAttrCount;
+                    attrs.arcFloatStride = arcFloatAttrCount;
+                    attrs.arcInts.resize(static_cast<size_t>(count) * arcIntAttrCount);
+                    attrs.arcFloats.resize(static_cast<size_t>(count) * arcFloatAttrCount);
                 }
-                else
+
+                return arc;
+            }
+
+            // Удалить дугу: на её место переходит последняя дуга вместе с атрибутами.
+            void removeArc(int arc)
+            {
+                auto const last = _targetCount - 1;
+                auto* const targets = _getTargetData();
+                if (_isIndexed())
                 {
-                    static_assert(std::is_same_v<AttrType, float>);
-                    resizeFloatAttrs(count);
+                    _unindexArc(arc);
+                    if (arc != last)
+                        _getIndexSlotOf(last) = arc;
+                }
+
+                targets[arc] = targets[last];
+                _targetCount = last;
+
+                if (_attributes)
+                {
+                    auto& attrs = *_attributes;
+                    auto const moveLast = [arc, last](auto& arcAttrs, int stride)
+                        {
+                            std::copy_n(
+                                    arcAttrs.begin() + static_cast<ptrdiff_t>(last) * stride,
+                                    stride,
+                                    arcAttrs.begin() + static_cast<ptrdiff_t>(arc) * stride
+                                );
+                            arcAttrs.resize(static_cast<size_t>(last) * stride);
+                        };
+
+                    moveLast(attrs.arcInts,   attrs.arcIntStride);
+                    moveLast(attrs.arcFloats, attrs.arcFloatStride);
                 }
             }
 
-            template <typename AttrType>
-            void reserveAttrs(int count)
+            // Выделить место под capacity дуг, чтобы addArc до этой степени не перераспределял память.
+            void reserveArcs(int capacity, int arcIntAttrCount, int arcFloatAttrCount)
             {
-                if constexpr (std::is_same_v<AttrType, int>)
+                if (capacity > _targetCapacity)
+                    _reallocateTargets(capacity);
+
+                if (arcIntAttrCount > 0 || arcFloatAttrCount > 0)
                 {
-                    reserveIntAttrs(count);
+                    auto& attrs = _getAttributes();
+                    attrs.arcInts.reserve(static_cast<size_t>(capacity) * arcIntAttrCount);
+                    attrs.arcFloats.reserve(static_cast<size_t>(capacity) * arcFloatAttrCount);
                 }
-                else
+            }
+
+            // Номер дуги в target или -1.
+            [[nodiscard]] auto findArc(int target) const noexcept
+                -> int
+            {
+                if (!_isIndexed())
                 {
-                    static_assert(std::is_same_v<AttrType, float>);
-                    reserveFloatAttrs(count);
+                    auto const targets = getTargets();
+                    auto const it = std::ranges::find(targets, target);
+                    return it == targets.end()? -1: static_cast<int>(it - targets.begin());
+                }
+
+                auto const* const slots = _heapTargets + _targetCapacity;
+                auto const mask = getIndexSlotCount(_targetCapacity) - 1;
+                for (auto slot = _getIndexSlot(target); ; slot = (slot + 1) & mask)
+                {
+                    auto const arc = slots[slot];
+                    if (arc < 0 || _heapTargets[arc] == target)
+                        return arc;
                 }
             }
 
-            [[nodiscard]] auto getIntAttrs() noexcept
-                -> std::span<int>
+            void resizeIntAttrs(int count)
             {
-                return _intAttrs;
+                if (_attributes || count > 0)
+                    _getAttributes().ints.resize(static_cast<size_t>(count));
+            }
+
+            void resizeFloatAttrs(int count)
+            {
+                if (_attributes || count > 0)
+                    _getAttributes().floats.resize(static_cast<size_t>(count));
+            }
+
+            void resizeArcsIntAttrs(int count)
+            {
+                if (_attributes || count > 0)
+                {
+                    auto& attrs = _getAttributes();
+                    restride(attrs.arcInts, attrs.arcIntStride, count, _targetCount);
+                }
+            }
+
+            void resizeArcsFloatAttrs(int count)
+            {
+                if (_attributes || count > 0)
+                {
+                    auto& attrs = _getAttributes();
+                    restride(attrs.arcFloats, attrs.arcFloatStride, count, _targetCount);
+                }
+            }
+
+            [[nodiscard]] auto getTargets() const noexcept
+                -> std::span<int const>
+            {
+                return { _getTargetData(), static_cast<size_t>(_targetCount) };
             }
 
             [[nodiscard]] auto getIntAttrs() const noexcept
                 -> std::span<int const>
             {
-                return _intAttrs;
+                return _attributes? std::span<int const>(_attributes->ints): std::span<int const>{};
+            }
+
+            [[nodiscard]] auto getIntAttrs() noexcept
+                -> std::span<int>
+            {
+                return _attributes? std::span<int>(_attributes->ints): std::span<int>{};
+            }
+
+            [[nodiscard]] auto getFloatAttrs() const noexcept
+                -> std::span<float const>
+            {
+                return _attributes? std::span<float const>(_attributes->floats): std::span<float const>{};
             }
 
             [[nodiscard]] auto getFloatAttrs() noexcept
                 -> std::span<float>
             {
-                return _floatAttrs;
+                return _attributes? std::span<float>(_attributes->floats): std::span<float>{};
             }
 
-            [[nodiscard]] auto getFloatAttrs() const noexcept
+            [[nodiscard]] auto getArcIntAttrs(int arc) const noexcept
+                -> std::span<int const>
+            {
+                if (!_attributes)
+                    return {};
+                auto const stride = static_cast<size_t>(_attributes->arcIntStride);
+                return std::span<int const>(_attributes->arcInts).subspan(arc * stride, stride);
+            }
+
+            [[nodiscard]] auto getArcIntAttrs(int arc) noexcept
+                -> std::span<int>
+            {
+                if (!_attributes)
+                    return {};
+                auto const stride = static_cast<size_t>(_attributes->arcIntStride);
+                return std::span<int>(_attributes->arcInts).subspan(arc * stride, stride);
+            }
+
+            [[nodiscard]] auto getArcFloatAttrs(int arc) const noexcept
                 -> std::span<float const>
             {
-                return _floatAttrs;
+                if (!_attributes)
+                    return {};
+                auto const stride = static_cast<size_t>(_attributes->arcFloatStride);
+                return std::span<float const>(_attributes->arcFloats).subspan(arc * stride, stride);
             }
 
-            template <typename AttrType, typename Self>
-            [[nodiscard]] auto getAttrs(this Self&& self) noexcept
+            [[nodiscard]] auto getArcFloatAttrs(int arc) noexcept
+                -> std::span<float>
             {
-                if constexpr (std::is_same_v<AttrType, int>)
-                {
-                    return self.getIntAttrs();
-                }
-                else
-                {
-                    static_assert(std::is_same_v<AttrType, float>);
-                    return self.getFloatAttrs();
-                }
+                if (!_attributes)
+                    return {};
+                auto const stride = static_cast<size_t>(_attributes->arcFloatStride);
+                return std::span<float>(_attributes->arcFloats).subspan(arc * stride, stride);
             }
 
         private:
-            std::vector<int>   _intAttrs;
-            std::vector<float> _floatAttrs;
-        };
+            allocator_type  _allocator;
+            int             _targetCount    = 0;
+            int             _targetCapacity = inlineTargetCount;
+            union
+            {
+                int         _inlineTargets[inlineTargetCount];
+                int*        _heapTargets;
+            };
+            Attributes*     _attributes     = nullptr;
 
 
-        class ArcAttributes
-            : public AttributesBase
-        {
-            // Пусто.
-        };
+            [[nodiscard]] bool _isInline() const noexcept
+            {
+                return _targetCapacity <= inlineTargetCount;
+            }
 
+            [[nodiscard]] bool _isIndexed() const noexcept
+            {
+                return _targetCapacity >= indexedTargetCount;
+            }
 
-        // Инварианты (причина для оформления в отдельный класс):
-        // targets.size() == arcsAttrs.size()
-        // exists s1, s2 forall x in arcsAttrs:
-        //          x.intAttrs.size() == s1 && x.floatAttrs.size() == s2
-        // -- у каждой вершины одинаковое число атрибутов.
-        class Vertex
-            : public AttributesBase
-        {
-        public:
-            void resizeArcs(int count, int arcIntAttrCount, int arcFloatAttrCount)
+            [[nodiscard]] auto _getIndexSlot(int target) const noexcept
+                -> int
             {
-                auto const oldSize = _targets.size();
-                auto const newSize = static_cast<size_t>(count);
+                // Мультипликативный хеш: старшие биты произведения равномерны и для целей с общим шагом.
+                auto const bits = std::bit_width(static_cast<unsigned>(getIndexSlotCount(_targetCapacity))) - 1;
+                return static_cast<int>((static_cast<uint64_t>(static_cast<uint32_t>(target)) * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+            }
 
-                _targets.resize(newSize);
-                _arcsAttrs.resize(newSize);
+            // Ячейка индекса, хранящая номер дуги arc (дуга должна быть в индексе).
+            [[nodiscard]] auto _getIndexSlotOf(int arc) noexcept
+                -> int&
+            {
+                auto* const slots = _heapTargets + _targetCapacity;
+                auto const mask = getIndexSlotCount(_targetCapacity) - 1;
+                auto slot = _getIndexSlot(_heapTargets[arc]);
+                while (slots[slot] != arc)
+                    slot = (slot + 1) & mask;
+                return slots[slot];
+            }
 
-                for (size_t i = oldSize; i < newSize; ++i)
+            // Удаление со сдвигом назад: следующие за дыркой элементы цепочки, чья начальная
+            // ячейка не лежит между дыркой и ними, переносятся в дырку; меток удаления не остаётся.
+            void _unindexArc(int arc) noexcept
+            {
+                auto* const slots = _heapTargets + _targetCapacity;
+                auto const mask = getIndexSlotCount(_targetCapacity) - 1;
+                auto hole = static_cast<int>(&_getIndexSlotOf(arc) - slots);
+                for (auto next = (hole + 1) & mask; slots[next] >= 0; next = (next + 1) & mask)
                 {
-                    auto& arc = _arcsAttrs[i];
-                    arc.resizeIntAttrs(arcIntAttrCount);
-                    arc.resizeFloatAttrs(arcFloatAttrCount);
+                    auto const home = _getIndexSlot(_heapTargets[slots[next]]);
+                    if (((next - home) & mask) >= ((next - hole) & mask))
+                    {
+                        slots[hole] = slots[next];
+                        hole = next;
+                    }
                 }
+                slots[hole] = -1;
             }
 
-            void reserveArcs(int capacity)
+            void _indexArc(int arc) noexcept
             {
-                _targets.reserve(capacity);
-                _arcsAttrs.reserve(capacity);
+                auto* const slots = _heapTargets + _targetCapacity;
+                auto const mask = getIndexSlotCount(_targetCapacity) - 1;
+                auto slot = _getIndexSlot(_heapTargets[arc]);
+                while (slots[slot] >= 0)
+                    slot = (slot + 1) & mask;
+                slots[slot] = arc;
             }
 
-            void resizeArcsIntAttrs(int count)
+            [[nodiscard]] auto _getTargetData() const noexcept
+                -> int const*
             {
-                for (auto& arc: _arcsAttrs)
-                    arc.resizeIntAttrs(count);
+                return _isInline()? _inlineTargets: _heapTargets;
             }
 
-            void reserveArcsIntAttrs(int capacity)
+            [[nodiscard]] auto _getTargetData() noexcept
+                -> int*
             {
-                for (auto& arc: _arcsAttrs)
-                    arc.reserveIntAttrs(capacity);
+                return _isInline()? _inlineTargets: _heapTargets;
             }
 
-            void resizeArcsFloatAttrs(int count)
+            [[nodiscard]] auto _getAttributes()
+                -> Attributes&
             {
-                for (auto& arc: _arcsAttrs)
-                    arc.resizeFloatAttrs(count);
+                if (!_attributes)
+                    _attributes = _allocator.new_object<Attributes>();
+                return *_attributes;
             }
 
-            void reserveArcsFloatAttrs(int capacity)
+            void _reallocateTargets(int capacity)
             {
-                for (auto& arc: _arcsAttrs)
-                    arc.reserveFloatAttrs(capacity);
-            }
+                auto const slotCount = getIndexSlotCount(capacity);
+                auto* const data = _allocator.allocate_object<int>(static_cast<size_t>(capacity + slotCount));
+                std::copy_n(_getTargetData(), _targetCount, data);
+                std::fill_n(data + capacity, slotCount, -1);
+                _releaseTargets();
+                _heapTargets    = data;
+                _targetCapacity = capacity;
 
-            template <typename AttrType>
-            void resizeArcsAttrs(int count)
-            {
-                if constexpr (std::is_same_v<AttrType, int>)
-                {
-                    resizeArcsIntAttrs(count);
-                }
-                else
+                if (_isIndexed())
                 {
-                    static_assert(std::is_same_v<AttrType, float>);
-                    resizeArcsFloatAttrs(count);
+                    for (int arc = 0; arc < _targetCount; ++arc)
+                        _indexArc(arc);
                 }
             }
 
-            template <typename AttrType>
-            void reserveArcsAttrs(int count)
+            void _releaseTargets() noexcept
             {
-                if constexpr (std::is_same_v<AttrType, int>)
-                {
-                    reserveArcsIntAttrs(count);
-                }
-                else
+                if (!_isInline())
                 {
-                    static_assert(std::is_same_v<AttrType, float>);
-                    reserveArcsFloatAttrs(count);
+                    auto const size = _targetCapacity + getIndexSlotCount(_targetCapacity);
+                    _allocator.deallocate_object(_heapTargets, static_cast<size_t>(size));
                 }
             }
 
-            [[nodiscard]] auto getTargets() const noexcept
-                -> std::span<int const>
+            void _copy(Vertex const& other)
             {
-                return _targets;
-            }
+                if (other._targetCount > inlineTargetCount)
+                    _reallocateTargets(other._targetCount);
+                std::ranges::copy(other.getTargets(), _getTargetData());
+                _targetCount = other._targetCount;
+                if (_isIndexed())
+                {
+                    for (int arc = 0; arc < _targetCount; ++arc)
+                        _indexArc(arc);
+                }
 
-            [[nodiscard]] auto getTargets() noexcept
-                -> std::span<int>
-            {
-                return _targets;
+                if (other._attributes)
+                    _attributes = _allocator.new_object<Attributes>(*other._attributes);
             }
 
-            [[nodiscard]] auto getArcsAttrs() const noexcept
-                -> std::span<ArcAttributes const>
+            void _steal(Vertex& other) noexcept
             {
-                return _arcsAttrs;
-            }
+                _targetCount    = other._targetCount;
+                _targetCapacity = other._targetCapacity;
+                if (_isInline())
+                    std::copy_n(other._inlineTargets, _targetCount, _inlineTargets);
+                else
+                    _heapTargets = other._heapTargets;
+                _attributes = other._attributes;
 
-            [[nodiscard]] auto getArcsAttrs() noexcept
-                -> std::span<ArcAttributes>
-            {
-                return _arcsAttrs;
+                other._targetCount    = 0;
+                other._targetCapacity = inlineTargetCount;
+                other._attributes     = nullptr;
             }
-
-        private:
-            std::vector<int>            _targets;
-            std::vector<ArcAttributes>  _arcsAttrs;
-            std::vector<int>            _intAttrs;
-            std::vector<float>          _floatAttrs;
         };
 
+        static_assert(sizeof(void*) != 8 || sizeof(Vertex) == 48);
+
 
         // Инварианты:
         // exists s1, s2 forall x in _vd:
         //      x.intAttrs.size() == s1 && x.floatAttrs.size() == s2
         // размеры вложенных в arcsAttrs intAttrs и floatAttrs должны совпадать у разных вершин
         class VertexData
-            : private std::vector<Vertex>
+            : private std::pmr::vector<Vertex>
         {
-            using Base = std::vector<Vertex>;
+            using Base = std::pmr::vector<Vertex>;
 
             int _vertexIntAttrCount   = 0;
             int _vertexFloatAttrCount = 0;
@@ -249,6 +509,12 @@ namespace gravis24
             int _arcFloatAttrCount    = 0;
 
         public:
+            explicit VertexData(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+                : Base(resource)
+            {
+                // Пусто.
+            }
+
             using Base::empty;
             using Base::data;
             using Base::begin;
@@ -390,9 +656,10 @@ namespace gravis24
             : public AdjacencyListView::ConstArcHandle
         {
         public:
-            ConstArcHandleImpl(int target, ArcAttributes const& attrs) noexcept
+            ConstArcHandleImpl(int target, Vertex const& source, int arc) noexcept
                 : _target{ target }
-                , _attrs{ &attrs }
+                , _intAttrs{ source.getArcIntAttrs(arc) }
+                , _floatAttrs{ source.getArcFloatAttrs(arc) }
             {
                 // Пусто.
             }
@@ -406,18 +673,19 @@ namespace gravis24
             auto getIntAttributes() const noexcept
                 -> std::span<int const> override
             {
-                return _attrs->getIntAttrs();
+                return _intAttrs;
             }
 
             auto getFloatAttributes() const noexcept
                 -> std::span<float const> override
             {
-                return _attrs->getFloatAttrs();
+                return _floatAttrs;
             }
 
         private:
-            int                  _target {-1};
-            ArcAttributes const* _attrs  {};
+            int                    _target {-1};
+            std::span<int const>   _intAttrs;
+            std::span<float const> _floatAttrs;
         };
 
 
@@ -425,9 +693,10 @@ namespace gravis24
             : public EditableAdjacencyList::ArcHandle
         {
         public:
-            ArcHandleImpl(int target, ArcAttributes& attrs) noexcept
+            ArcHandleImpl(int target, Vertex& source, int arc) noexcept
                 : _target{ target }
-                , _attrs{ &attrs }
+                , _intAttrs{ source.getArcIntAttrs(arc) }
+                , _floatAttrs{ source.getArcFloatAttrs(arc) }
             {
                 // Пусто.
             }
@@ -441,30 +710,31 @@ namespace gravis24
             auto getIntAttributes() const noexcept
                 -> std::span<int const> override
             {
-                return _attrs->getIntAttrs();
+                return _intAttrs;
             }
 
             auto getFloatAttributes() const noexcept
                 -> std::span<float const> override
             {
-                return _attrs->getFloatAttrs();
+                return _floatAttrs;
             }
 
             auto getIntAttributes() noexcept
                 -> std::span<int> override
             {
-                return _attrs->getIntAttrs();
+                return _intAttrs;
             }
 
             auto getFloatAttributes() noexcept
                 -> std::span<float> override
             {
-                return _attrs->getFloatAttrs();
+                return _floatAttrs;
             }
 
         private:
-            int            _target {-1};
-            ArcAttributes* _attrs  {};
+            int              _target {-1};
+            std::span<int>   _intAttrs;
+            std::span<float> _floatAttrs;
         };
 
     }
@@ -486,7 +756,7 @@ namespace gravis24
         [[nodiscard]] bool areConnected(int source, int target) const noexcept override
         {
             return isValidVertex(source)
-                && std::ranges::contains(_vd[source].getTargets(), target);
+                && _vd[source].findArc(target) >= 0;
         }
 
         [[nodiscard]] auto getTargetCount(int vertex) const noexcept
@@ -556,13 +826,11 @@ namespace gravis24
                 return {};
 
             auto& sourceData = _vd[source];
-            auto  targets    = sourceData.getTargets();
-            auto const it    = std::ranges::find(targets, target);
-            if (it == targets.end())
+            auto const index = sourceData.findArc(target);
+            if (index < 0)
                 return {};
 
-            auto const index = std::distance(targets.begin(), it);
-            return std::make_unique<ConstArcHandleImpl>(target, sourceData.getArcsAttrs()[index]);
+            return std::make_unique<ConstArcHandleImpl>(target, sourceData, index);
         }
 
         /////////////////////////////////////////////////////
@@ -581,6 +849,16 @@ namespace gravis24
                 );
         }
 
+        void resizeArcIntAttributes(int attributeCount) override
+        {
+            _vd.resize(_vd.size(), -1, -1, attributeCount);
+        }
+
+        void resizeArcFloatAttributes(int attributeCount) override
+        {
+            _vd.resize(_vd.size(), -1, -1, -1, attributeCount);
+        }
+
         auto addVertex() 
             -> int override
         {
@@ -591,21 +869,39 @@ namespace gravis24
 
         bool connect(int source, int target) override
         {
+            if (source < 0 || target < 0)
+                return false;
+
             auto const max_required_size = std::max(source, target) + 1;
             if (_vd.size() < max_required_size)
                 _vd.resize(max_required_size);
 
-            auto&      vertex   = _vd[source];
-            auto const arcIndex = static_cast<int>(vertex.getTargets().size());
-            vertex.resizeArcs(arcIndex + 1, getArcIntAttributeCount(), getArcFloatAttributeCount());
-            vertex.getTargets()[arcIndex] = target;
+            auto& vertex = _vd[source];
+            if (vertex.findArc(target) >= 0)
+                return false;
+
+            vertex.addArc(target, getArcIntAttributeCount(), getArcFloatAttributeCount());
             return true;
         }
 
         bool disconnect(int source, int target) override
         {
-            return static_cast<size_t>(source) < _vd.size()
-                && std::ranges::contains(_vd[source].getTargets(), target);
+            if (!isValidVertex(source))
+                return false;
+
+            auto& vertex = _vd[source];
+            auto const arc = vertex.findArc(target);
+            if (arc < 0)
+                return false;
+
+            vertex.removeArc(arc);
+            return true;
+        }
+
+        void reserveArcs(int vertex, int capacity) override
+        {
+            if (isValidVertex(vertex))
+                _vd[vertex].reserveArcs(capacity, getArcIntAttributeCount(), getArcFloatAttributeCount());
         }
 
         [[nodiscard]] auto getVertexIntAttributes(int vertex) noexcept
@@ -631,13 +927,11 @@ namespace gravis24
                 return {};
 
             auto& sourceData = _vd[source];
-            auto  targets    = sourceData.getTargets();
-            auto const it    = std::ranges::find(targets, target);
-            if (it == targets.end())
+            auto const index = sourceData.findArc(target);
+            if (index < 0)
                 return {};
 
-            auto const index = std::distance(targets.begin(), it);
-            return std::make_unique<ArcHandleImpl>(target, sourceData.getArcsAttrs()[index]);
+            return std::make_unique<ArcHandleImpl>(target, sourceData, index);
         }
 
         /////////////////////////////////////////////////////
@@ -650,6 +944,12 @@ namespace gravis24
             _vd.resize(vertexCount);
         }
 
+        AdjacencyListVector(int vertexCount, std::pmr::memory_resource* resource)
+            : _vd(resource)
+        {
+            _vd.resize(vertexCount);
+        }
+
     private:
         VertexData _vd;
 
@@ -671,25 +971,6 @@ namespace gravis24
             return isValidVertex(vertexIndex) 
                 && static_cast<size_t>(attrIndex) < _vd[vertexIndex].getFloatAttrs().size();
         }
-        
-        template <typename AttrType, typename Self>
-        [[nodiscard]] auto getArcAttrs(this Self&& self, int source, int target) noexcept
-        {
-            using Result = decltype(self._vd[0].getArcsAttrs()[0].template getAttrs<AttrType>());
-            if (self.isValidVertex(source))
-            {
-                auto& sourceData = self._vd[source];
-                auto  targets    = sourceData.getTargets();
-                auto const it    = std::ranges::find(targets, target);
-                if (it != targets.end())
-                {
-                    auto const index = std::distance(targets.begin(), it);
-                    return sourceData.getArcsAttrs()[index].template getAttrs<AttrType>();
-                }
-            }
-            
-            return Result{};
-        }
     };
 
 
@@ -699,4 +980,11 @@ namespace gravis24
         return std::make_unique<AdjacencyListVector>(vertexCount);
     }
 
+
+    auto newAdjacencyListVector(int vertexCount, std::pmr::memory_resource* resource)
+        -> std::unique_ptr<EditableAdjacencyList>
+    {
+        return std::make_unique<AdjacencyListVector>(vertexCount, resource);
+    }
+
 }
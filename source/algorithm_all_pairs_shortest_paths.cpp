@@ -0,0 +1,245 @@
+/// @file  algorithm_all_pairs_shortest_paths.cpp
+/// @brief Блочный алгоритм Флойда -- Уоршелла с ядром (min, +) на AVX2
+///        (если включено при компиляции: /arch:AVX2 для MSVC, -mavx2 для GCC/Clang).
+#include "../include/algorithm_all_pairs_shortest_paths.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        constexpr float infinity  = std::numeric_limits<float>::infinity();
+
+        // 64 x 64 float = 16 Кбайт: три блока (C, A, B) помещаются в L2, строка C -- в 8 регистрах AVX.
+        constexpr int   blockSize = 64;
+
+
+        // Блок матрицы: указатель на левый верхний элемент и длина строки матрицы.
+        struct Block
+        {
+            float* data;
+            size_t stride;
+
+            [[nodiscard]] auto row(int i) const noexcept
+                -> float*
+            {
+                return data + i * stride;
+            }
+        };
+
+
+        // c[j] = min(c[j], a + b[j]), j < blockSize.
+        inline void minPlusRow(float* c, float a, float const* b) noexcept
+        {
+#if defined(__AVX2__)
+            auto const va = _mm256_set1_ps(a);
+            for (int j = 0; j < blockSize; j += 8)
+            {
+                auto const sum = _mm256_add_ps(va, _mm256_loadu_ps(b + j));
+                _mm256_storeu_ps(c + j, _mm256_min_ps(_mm256_loadu_ps(c + j), sum));
+            }
+#else
+            for (int j = 0; j < blockSize; ++j)
+                c[j] = std::min(c[j], a + b[j]);
+#endif
+        }
+
+
+        // Блоки могут совпадать (фазы 1 и 2): порядок k -- внешний цикл, как в обычном алгоритме.
+        void relaxBlockInPlace(Block c, Block a, Block b) noexcept
+        {
+            for (int k = 0; k < blockSize; ++k)
+            {
+                auto const bk = b.row(k);
+                for (int i = 0; i < blockSize; ++i)
+                    minPlusRow(c.row(i), a.row(i)[k], bk);
+            }
+        }
+
+
+        // Блоки различны (фаза 3): строка C остаётся в регистрах на протяжении всего цикла по k.
+        void relaxBlock(Block c, Block a, Block b) noexcept
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                auto const ci = c.row(i);
+                auto const ai = a.row(i);
+#if defined(__AVX2__)
+                __m256 acc[blockSize / 8];
+                for (int j = 0; j < blockSize / 8; ++j)
+                    acc[j] = _mm256_loadu_ps(ci + 8 * j);
+
+                for (int k = 0; k < blockSize; ++k)
+                {
+                    auto const va = _mm256_set1_ps(ai[k]);
+                    auto const bk = b.row(k);
+                    for (int j = 0; j < blockSize / 8; ++j)
+                        acc[j] = _mm256_min_ps(acc[j], _mm256_add_ps(va, _mm256_loadu_ps(bk + 8 * j)));
+                }
+
+                for (int j = 0; j < blockSize / 8; ++j)
+                    _mm256_storeu_ps(ci + 8 * j, acc[j]);
+#else
+                for (int k = 0; k < blockSize; ++k)
+                    minPlusRow(ci, ai[k], b.row(k));
+#endif
+            }
+        }
+
+
+        void runBlockedFloydWarshall(DistanceMatrix& dm)
+        {
+            auto const stride     = dm.getStride();
+            auto const blockCount = static_cast<int>(stride / blockSize);
+            auto const block = [&dm, stride](int bi, int bj) noexcept
+                {
+                    return Block
+                    {
+                        .data   = dm.data() + size_t(bi) * blockSize * stride + size_t(bj) * blockSize,
+                        .stride = stride
+                    };
+                };
+
+            for (int kb = 0; kb < blockCount; ++kb)
+            {
+                auto const pivot = block(kb, kb);
+                relaxBlockInPlace(pivot, pivot, pivot);
+
+                // Строка и столбец блоков kb: 2 * (blockCount - 1) независимых блоков.
+                parallelForBlocks(2 * blockCount, 1,
+                    [&](int, int begin, int end)
+                    {
+                        for (int n = begin; n < end; ++n)
+                        {
+                            auto const other = n / 2;
+                            if (other == kb)
+                                continue;
+
+                            if (n % 2 == 0)
+                            {
+                                auto const c = block(kb, other);
+                                relaxBlockInPlace(c, pivot, c);
+                            }
+                            else
+                            {
+                                auto const c = block(other, kb);
+                                relaxBlockInPlace(c, c, pivot);
+                            }
+                        }
+                    });
+
+                // Остальные блоки зависят только от строки и столбца kb.
+                parallelForBlocks(blockCount * blockCount, 1,
+                    [&](int, int begin, int end)
+                    {
+                        for (int n = begin; n < end; ++n)
+                        {
+                            auto const bi = n / blockCount;
+                            auto const bj = n % blockCount;
+                            if (bi != kb && bj != kb)
+                                relaxBlock(block(bi, bj), block(bi, kb), block(kb, bj));
+                        }
+                    });
+            }
+        }
+
+
+        void seedFromMatrix(DistanceMatrix& dm, DenseAdjacencyMatrixView const& am)
+        {
+            auto const vertexCount = dm.getVertexCount();
+            for (int s = 0; s < vertexCount; ++s)
+            {
+                auto const row = am.getRow(s);
+                for (int t = 0; t < vertexCount; ++t)
+                    if (s != t && row.getBit(t))
+                        dm(s, t) = 1.f;
+            }
+        }
+
+    }
+
+
+    DistanceMatrix::DistanceMatrix(int vertexCount)
+        : _vertexCount{ std::max(vertexCount, 0) }
+        , _stride{ (static_cast<size_t>(_vertexCount) + blockSize - 1) / blockSize * blockSize }
+        , _data(_stride * _stride, infinity)
+    {
+        for (int v = 0; v < _vertexCount; ++v)
+            (*this)(v, v) = 0.f;
+    }
+
+
+    auto computeAllPairsShortestPaths(DenseAdjacencyMatrixView const& am)
+        -> DistanceMatrix
+    {
+        DistanceMatrix dm(am.getVertexCount());
+        seedFromMatrix(dm, am);
+        runBlockedFloydWarshall(dm);
+        return dm;
+    }
+
+
+    auto computeAllPairsShortestPaths(
+            DenseAdjacencyMatrixView const& am,
+            EdgeListView const&             el,
+            int                             weightAttribute
+        ) -> DistanceMatrix
+    {
+        if (static_cast<unsigned>(weightAttribute) >= static_cast<unsigned>(el.getFloatAttributeCount()))
+            return {};
+
+        auto const weights = el.getFloatAttributes(weightAttribute);
+        auto const arcs    = el.getArcs();
+        if (weights.size() != arcs.size())
+            return {};
+        if (std::ranges::any_of(weights, [](float w) { return std::isnan(w); }))
+            return {};
+
+        auto const vertexCount = am.getVertexCount();
+        DistanceMatrix dm(vertexCount);
+        seedFromMatrix(dm, am);
+
+        // Дуги, у которых есть вес, получают наименьший из своих весов.
+        std::vector<bool> weighted(static_cast<size_t>(vertexCount) * vertexCount);
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            auto const [s, t] = arcs[i];
+            if (static_cast<unsigned>(s) >= static_cast<unsigned>(vertexCount)
+             || static_cast<unsigned>(t) >= static_cast<unsigned>(vertexCount)
+             || !am.getRow(s).getBit(t))
+                continue;
+
+            auto const index = static_cast<size_t>(s) * vertexCount + t;
+            auto& d = dm(s, t);
+            if (s == t)
+                d = std::min(d, weights[i]);
+            else
+                d = weighted[index]? std::min(d, weights[i]): weights[i];
+            weighted[index] = true;
+        }
+
+        runBlockedFloydWarshall(dm);
+        return dm;
+    }
+
+
+    auto computeAllPairsShortestPaths(Graph const& graph, int weightAttribute)
+        -> DistanceMatrix
+    {
+        auto const& am = graph.getAdjacencyMatrixView();
+        if (weightAttribute < 0)
+            return computeAllPairsShortestPaths(am);
+        return computeAllPairsShortestPaths(am, graph.getEdgeListView(), weightAttribute);
+    }
+
+}
@@ -0,0 +1,219 @@
+/// @file  algorithm_centrality.cpp
+/// @brief Параллельный алгоритм Брандеса (точный и по выборке источников),
+///        близость и гармоническая центральность на общем ядре обхода в ширину.
+#include "../include/algorithm_centrality.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        // Буферы обхода в ширину одного потока. После обхода сбрасываются
+        // только посещённые вершины, поэтому обход стоит O(посещённые вершины и дуги).
+        class BreadthFirstSearch
+        {
+        public:
+            /// Расстояния от источника, -1 для непосещённых вершин.
+            std::vector<int>    distance;
+            /// Число кратчайших путей от источника (если считается).
+            std::vector<double> paths;
+            /// Посещённые вершины в порядке обхода (по неубыванию расстояния).
+            std::vector<int>    order;
+
+            void prepare(int vertexCount, bool countPaths)
+            {
+                if (distance.empty())
+                {
+                    distance.assign(static_cast<size_t>(vertexCount), -1);
+                    order.reserve(static_cast<size_t>(vertexCount));
+                    if (countPaths)
+                        paths.resize(static_cast<size_t>(vertexCount));
+                }
+            }
+
+            template <bool countPaths>
+            void run(CompressedAdjacency const& graph, int source)
+            {
+                for (int const v: order)
+                    distance[v] = -1;
+                order.clear();
+
+                distance[source] = 0;
+                if constexpr (countPaths)
+                    paths[source] = 1.;
+                order.push_back(source);
+
+                for (size_t head = 0; head < order.size(); ++head)
+                {
+                    auto const v    = order[head];
+                    auto const next = distance[v] + 1;
+                    for (int const t: graph.getTargets(v))
+                    {
+                        if (distance[t] < 0)
+                        {
+                            distance[t] = next;
+                            order.push_back(t);
+                            if constexpr (countPaths)
+                                paths[t] = 0.;
+                        }
+
+                        if constexpr (countPaths)
+                            if (distance[t] == next)
+                                paths[t] += paths[v];
+                    }
+                }
+            }
+        };
+
+
+        // Посредничество по заданным источникам, умноженное на scale.
+        [[nodiscard]] auto accumulateBetweenness(
+                CompressedAdjacency const& graph,
+                std::vector<int> const&    sources,
+                double                     scale
+            ) -> std::vector<float>
+        {
+            auto const vertexCount = graph.getVertexCount();
+            auto const workerCount = static_cast<size_t>(getWorkerCount());
+
+            std::vector<BreadthFirstSearch>  searches(workerCount);
+            std::vector<std::vector<double>> dependency(workerCount);
+            std::vector<std::vector<double>> centrality(workerCount);
+            parallelForBlocks(static_cast<int>(sources.size()), 4,
+                [&](int worker, int begin, int end)
+                {
+                    auto& search = searches[worker];
+                    auto& delta  = dependency[worker];
+                    auto& sum    = centrality[worker];
+                    search.prepare(vertexCount, true);
+                    delta.resize(static_cast<size_t>(vertexCount));
+                    sum.resize(static_cast<size_t>(vertexCount));
+
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto const source = sources[i];
+                        search.run<true>(graph, source);
+
+                        // Зависимость w -- сумма по преемникам x на кратчайших путях;
+                        // в обратном порядке обхода все преемники уже обработаны.
+                        auto const& distance = search.distance;
+                        auto const& paths    = search.paths;
+                        for (auto it = search.order.rbegin(); it != search.order.rend(); ++it)
+                        {
+                            auto const w    = *it;
+                            auto const next = distance[w] + 1;
+                            double dw = 0.;
+                            for (int const x: graph.getTargets(w))
+                                if (distance[x] == next)
+                                    dw += paths[w] / paths[x] * (1. + delta[x]);
+
+                            delta[w] = dw;
+                            if (w != source)
+                                sum[w] += dw;
+                        }
+                    }
+                });
+
+            std::vector<float> result(static_cast<size_t>(vertexCount));
+            parallelForBlocks(vertexCount, 4096,
+                [&](int, int begin, int end)
+                {
+                    for (int v = begin; v < end; ++v)
+                    {
+                        double total = 0.;
+                        for (auto const& sum: centrality)
+                            if (!sum.empty())
+                                total += sum[v];
+                        result[v] = static_cast<float>(total * scale);
+                    }
+                });
+
+            return result;
+        }
+
+    }
+
+
+    auto computeBetweennessCentrality(AdjacencyListView const& al)
+        -> std::vector<float>
+    {
+        auto const graph = CompressedAdjacency::fromAdjacencyList(al);
+        std::vector<int> sources(static_cast<size_t>(graph.getVertexCount()));
+        std::iota(sources.begin(), sources.end(), 0);
+        return accumulateBetweenness(graph, sources, 1.);
+    }
+
+
+    auto computeApproximateBetweennessCentrality(
+            AdjacencyListView const& al,
+            int                      sampleCount,
+            uint64_t                 seed
+        ) -> std::vector<float>
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al);
+        auto const vertexCount = graph.getVertexCount();
+        sampleCount = std::clamp(sampleCount, 0, vertexCount);
+
+        // Первые sampleCount шагов перемешивания Фишера -- Йетса.
+        std::vector<int> sources(static_cast<size_t>(vertexCount));
+        std::iota(sources.begin(), sources.end(), 0);
+        std::mt19937_64 random(seed);
+        for (int i = 0; i < sampleCount; ++i)
+        {
+            std::uniform_int_distribution<int> pick(i, vertexCount - 1);
+            std::swap(sources[i], sources[pick(random)]);
+        }
+
+        sources.resize(static_cast<size_t>(sampleCount));
+        std::ranges::sort(sources);
+        auto const scale = sampleCount > 0? static_cast<double>(vertexCount) / sampleCount: 0.;
+        return accumulateBetweenness(graph, sources, scale);
+    }
+
+
+    auto computeClosenessCentrality(AdjacencyListView const& al)
+        -> ClosenessCentrality
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al);
+        auto const vertexCount = graph.getVertexCount();
+
+        ClosenessCentrality result;
+        result.closeness.resize(static_cast<size_t>(vertexCount));
+        result.harmonic.resize(static_cast<size_t>(vertexCount));
+
+        std::vector<BreadthFirstSearch> searches(static_cast<size_t>(getWorkerCount()));
+        parallelForBlocks(vertexCount, 4,
+            [&](int worker, int begin, int end)
+            {
+                auto& search = searches[worker];
+                search.prepare(vertexCount, false);
+                for (int v = begin; v < end; ++v)
+                {
+                    search.run<false>(graph, v);
+
+                    double total = 0., harmonic = 0.;
+                    for (size_t i = 1; i < search.order.size(); ++i)
+                    {
+                        auto const d = search.distance[search.order[i]];
+                        total    += d;
+                        harmonic += 1. / d;
+                    }
+
+                    auto const reached = static_cast<double>(search.order.size() - 1);
+                    if (total > 0.)
+                        result.closeness[v] = static_cast<float>(reached / (vertexCount - 1) * (reached / total));
+                    result.harmonic[v] = static_cast<float>(harmonic);
+                }
+            });
+
+        return result;
+    }
+
+}
@@ -0,0 +1,436 @@
+/// @file  algorithm_coarsening.cpp
+/// @brief Огрубление графа: параллельное паросочетание тяжёлых рёбер, присоединение
+///        вершин без пары и параллельное сжатие кластеров (нумерация префиксными суммами,
+///        слияние рёбер сортировкой по ключу).
+#include "../include/algorithm_coarsening.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <utility>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        constexpr int grain             = 1024;
+        constexpr int maxMatchingRounds = 8;
+
+
+        // Рёбра уровня: source < target, без повторов.
+        struct LevelEdges
+        {
+            std::vector<Arc>   arcs;
+            std::vector<int>   counts;
+            std::vector<float> weights;
+        };
+
+
+        // Неориентированный граф уровня: у вершины -- соседи и номера рёбер.
+        struct LevelGraph
+        {
+            std::vector<int> offsets;
+            std::vector<int> targets;
+            std::vector<int> edges;
+
+            [[nodiscard]] auto getVertexCount() const noexcept
+                -> int
+            {
+                return static_cast<int>(offsets.size()) - 1;
+            }
+        };
+
+
+        // numbers[i] -- число отмеченных элементов до i; возвращает общее число отмеченных.
+        // Отметки считаются параллельно по блокам, затем префиксные суммы по блокам.
+        template <typename IsFlagged>
+        auto numberFlagged(int count, IsFlagged isFlagged, std::vector<int>& numbers)
+            -> int
+        {
+            constexpr int blockSize = 1 << 14;
+            auto const blockCount = (count + blockSize - 1) / blockSize;
+            std::vector<int> blockStarts(static_cast<size_t>(blockCount) + 1, 0);
+            parallelForBlocks(blockCount, 1,
+                [&](int, int begin, int end)
+                {
+                    for (int block = begin; block < end; ++block)
+                    {
+                        int flagged = 0;
+                        for (int i = block * blockSize; i < std::min(count, (block + 1) * blockSize); ++i)
+                            flagged += isFlagged(i)? 1: 0;
+                        blockStarts[block + 1] = flagged;
+                    }
+                });
+            std::partial_sum(blockStarts.begin(), blockStarts.end(), blockStarts.begin());
+
+            numbers.resize(static_cast<size_t>(count));
+            parallelForBlocks(blockCount, 1,
+                [&](int, int begin, int end)
+                {
+                    for (int block = begin; block < end; ++block)
+                    {
+                        auto number = blockStarts[block];
+                        for (int i = block * blockSize; i < std::min(count, (block + 1) * blockSize); ++i)
+                        {
+                            numbers[i] = number;
+                            number += isFlagged(i)? 1: 0;
+                        }
+                    }
+                });
+
+            return blockStarts.back();
+        }
+
+
+        // Перенумеровать концы рёбер по clusters (пусто -- без перенумерации) и слить рёбра
+        // с одинаковыми концами; петли и дуги с концами вне [0, vertexCount) отбрасываются.
+        // counts и weights пусты -- у всех рёбер 1.
+        [[nodiscard]] auto contractEdges(
+                std::span<Arc const>   arcs,
+                std::span<int const>   counts,
+                std::span<float const> weights,
+                int                    vertexCount,
+                std::span<int const>   clusters
+            ) -> LevelEdges
+        {
+            struct Entry
+            {
+                uint64_t key;
+                int      index;
+            };
+
+            constexpr auto dropped = ~uint64_t {};
+            auto const arcCount = static_cast<int>(arcs.size());
+            std::vector<Entry> entries(arcs.size());
+            parallelForBlocks(arcCount, grain,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto [a, b] = arcs[i];
+                        entries[i] = { dropped, i };
+                        if (static_cast<unsigned>(a) >= static_cast<unsigned>(vertexCount)
+                         || static_cast<unsigned>(b) >= static_cast<unsigned>(vertexCount))
+                            continue;
+
+                        if (!clusters.empty())
+                        {
+                            a = clusters[a];
+                            b = clusters[b];
+                        }
+
+                        if (a == b)
+                            continue;
+
+                        if (a > b)
+                            std::swap(a, b);
+                        entries[i].key = static_cast<uint64_t>(a) << 32 | static_cast<uint32_t>(b);
+                    }
+                });
+
+            // По номеру дуги при равных ключах -- чтобы суммы весов не зависели от числа потоков.
+            parallelSort(entries.begin(), entries.end(),
+                [](Entry const& x, Entry const& y) noexcept
+                {
+                    return x.key != y.key? x.key < y.key: x.index < y.index;
+                });
+
+            auto const validCount = static_cast<int>(std::ranges::partition_point(entries,
+                [](Entry const& entry) noexcept
+                {
+                    return entry.key != dropped;
+                }) - entries.begin());
+
+            std::vector<int> runs;
+            auto const edgeCount = numberFlagged(validCount,
+                [&entries](int i) noexcept
+                {
+                    return i == 0 || entries[i].key != entries[i - 1].key;
+                }, runs);
+
+            std::vector<int> runStarts(static_cast<size_t>(edgeCount) + 1, validCount);
+            parallelForBlocks(validCount, grain,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                        if (i == 0 || entries[i].key != entries[i - 1].key)
+                            runStarts[runs[i]] = i;
+                });
+
+            LevelEdges result;
+            result.arcs.resize(static_cast<size_t>(edgeCount));
+            result.counts.resize(static_cast<size_t>(edgeCount));
+            result.weights.resize(static_cast<size_t>(edgeCount));
+            parallelForBlocks(edgeCount, grain,
+                [&](int, int begin, int end)
+                {
+                    for (int edge = begin; edge < end; ++edge)
+                    {
+                        auto const key = entries[runStarts[edge]].key;
+                        result.arcs[edge] = { static_cast<int>(key >> 32), static_cast<int>(key & 0xFFFF'FFFFu) };
+
+                        int    count  = 0;
+                        double weight = 0.;
+                        for (int i = runStarts[edge]; i < runStarts[edge + 1]; ++i)
+                        {
+                            auto const index = entries[i].index;
+                            count  += counts.empty()? 1: counts[index];
+                            weight += weights.empty()? 1.: weights[index];
+                        }
+
+                        result.counts[edge]  = count;
+                        result.weights[edge] = static_cast<float>(weight);
+                    }
+                });
+
+            return result;
+        }
+
+
+        [[nodiscard]] auto makeLevelGraph(LevelEdges const& edges, int vertexCount)
+            -> LevelGraph
+        {
+            LevelGraph g;
+            g.offsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+            for (auto const [a, b]: edges.arcs)
+            {
+                ++g.offsets[a + 1];
+                ++g.offsets[b + 1];
+            }
+
+            std::partial_sum(g.offsets.begin(), g.offsets.end(), g.offsets.begin());
+            g.targets.resize(static_cast<size_t>(g.offsets.back()));
+            g.edges.resize(g.targets.size());
+            std::vector<int> position(g.offsets.begin(), g.offsets.end() - 1);
+            for (int edge = 0; edge < static_cast<int>(edges.arcs.size()); ++edge)
+            {
+                auto const [a, b] = edges.arcs[edge];
+                auto const at   = position[a]++;
+                auto const back = position[b]++;
+                g.targets[at]   = b;
+                g.edges[at]     = edge;
+                g.targets[back] = a;
+                g.edges[back]   = edge;
+            }
+
+            return g;
+        }
+
+
+        // Кластер (представитель -- наименьшая вершина) каждой вершины:
+        // пары паросочетания тяжёлых рёбер и присоединённые к ним вершины без пары.
+        [[nodiscard]] auto findClusters(LevelGraph const& g, LevelEdges const& edges, uint64_t seed)
+            -> std::vector<int>
+        {
+            auto const vertexCount = g.getVertexCount();
+            auto const isHeavier = [&edges, seed](int e, int f) noexcept
+                {
+                    if (edges.weights[e] != edges.weights[f])
+                        return edges.weights[e] > edges.weights[f];
+                    return getPriority(seed, e) > getPriority(seed, f);
+                };
+
+            // "Рукопожатия": свободная вершина выбирает самое тяжёлое ребро к свободному соседу,
+            // взаимный выбор -- пара. Самое тяжёлое из таких рёбер всегда выбрано взаимно.
+            std::vector<int> mates(static_cast<size_t>(vertexCount), -1);
+            std::vector<int> proposals(static_cast<size_t>(vertexCount), -1);
+            std::vector<int> matchedByWorker(static_cast<size_t>(getWorkerCount()));
+            for (int round = 0; round < maxMatchingRounds; ++round)
+            {
+                parallelForBlocks(vertexCount, grain,
+                    [&](int, int begin, int end)
+                    {
+                        for (int v = begin; v < end; ++v)
+                        {
+                            proposals[v] = -1;
+                            if (mates[v] != -1)
+                                continue;
+
+                            int best = -1;
+                            for (int i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+                                if (mates[g.targets[i]] == -1 && (best == -1 || isHeavier(g.edges[i], g.edges[best])))
+                                    best = i;
+                            if (best != -1)
+                                proposals[v] = g.targets[best];
+                        }
+                    });
+
+                std::ranges::fill(matchedByWorker, 0);
+                parallelForBlocks(vertexCount, grain,
+                    [&](int worker, int begin, int end)
+                    {
+                        for (int v = begin; v < end; ++v)
+                        {
+                            auto const u = proposals[v];
+                            if (u != -1 && proposals[u] == v)
+                            {
+                                mates[v] = u;
+                                ++matchedByWorker[worker];
+                            }
+                        }
+                    });
+
+                if (std::reduce(matchedByWorker.begin(), matchedByWorker.end()) == 0)
+                    break;
+            }
+
+            std::vector<int> clusters(static_cast<size_t>(vertexCount));
+            parallelForBlocks(vertexCount, grain,
+                [&](int, int begin, int end)
+                {
+                    for (int v = begin; v < end; ++v)
+                    {
+                        if (mates[v] != -1)
+                        {
+                            clusters[v] = std::min(v, mates[v]);
+                            continue;
+                        }
+
+                        int best = -1;
+                        for (int i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+                            if (mates[g.targets[i]] != -1 && (best == -1 || isHeavier(g.edges[i], g.edges[best])))
+                                best = i;
+
+                        clusters[v] = v;
+                        if (best != -1)
+                            clusters[v] = std::min(g.targets[best], mates[g.targets[best]]);
+                    }
+                });
+
+            return clusters;
+        }
+
+
+        [[nodiscard]] auto makeGraph(LevelEdges const& edges, int vertexCount)
+            -> std::unique_ptr<Graph>
+        {
+            auto const edgeCount = static_cast<int>(edges.arcs.size());
+            auto el = newEdgeListUnsortedVector(edgeCount, 1, 1);
+            for (int edge = 0; edge < edgeCount; ++edge)
+            {
+                auto const index = el->connect(edges.arcs[edge].source, edges.arcs[edge].target);
+                el->getIntAttributes(CoarseLevel::arcCountAttribute)[index]    = edges.counts[edge];
+                el->getFloatAttributes(CoarseLevel::arcWeightAttribute)[index] = edges.weights[edge];
+            }
+
+            return newGraph(std::move(el), vertexCount);
+        }
+
+    }
+
+
+    auto computeCoarsening(
+            EdgeListView const&         el,
+            VertexPositionArrays const& positions,
+            CoarseningOptions const&    options
+        ) -> CoarseningHierarchy
+    {
+        auto const arcs = el.getArcs();
+        std::span<float const> column;
+        if (options.weightAttribute >= 0)
+        {
+            if (options.weightAttribute >= el.getFloatAttributeCount())
+                return {};
+            column = el.getFloatAttributes(options.weightAttribute);
+            if (column.size() < arcs.size())
+                return {};
+            column = column.first(arcs.size());
+            if (std::ranges::any_of(column, [](float w) noexcept { return !(w >= 0.f); }))
+                return {};
+        }
+
+        CoarseningHierarchy result;
+        auto vertexCount = positions.size();
+        auto edges = contractEdges(arcs, {}, column, vertexCount, {});
+        std::vector<int> fineWeights(static_cast<size_t>(vertexCount), 1);
+        auto const* finePositions = &positions;
+        while (static_cast<int>(result.levels.size()) < options.maxLevels && vertexCount > options.minVertexCount)
+        {
+            auto const g = makeLevelGraph(edges, vertexCount);
+            auto const clusters = findClusters(g, edges, options.seed + result.levels.size());
+
+            CoarseLevel level;
+            std::vector<int> numbers;
+            auto const coarseCount = numberFlagged(vertexCount,
+                [&clusters](int v) noexcept
+                {
+                    return clusters[v] == v;
+                }, numbers);
+            if (coarseCount == 0 || coarseCount > options.maxShrinkRatio * vertexCount)
+                break;
+
+            level.parents.resize(static_cast<size_t>(vertexCount));
+            parallelForBlocks(vertexCount, grain,
+                [&](int, int begin, int end)
+                {
+                    for (int v = begin; v < end; ++v)
+                        level.parents[v] = numbers[clusters[v]];
+                });
+
+            level.childOffsets.assign(static_cast<size_t>(coarseCount) + 1, 0);
+            for (int const parent: level.parents)
+                ++level.childOffsets[parent + 1];
+            std::partial_sum(level.childOffsets.begin(), level.childOffsets.end(), level.childOffsets.begin());
+            level.children.resize(static_cast<size_t>(vertexCount));
+            std::vector<int> position(level.childOffsets.begin(), level.childOffsets.end() - 1);
+            for (int v = 0; v < vertexCount; ++v)
+                level.children[position[level.parents[v]]++] = v;
+
+            edges = contractEdges(edges.arcs, edges.counts, edges.weights, vertexCount, level.parents);
+            level.graph = makeGraph(edges, coarseCount);
+
+            // Центры масс кластеров.
+            level.vertexWeights.resize(static_cast<size_t>(coarseCount));
+            {
+                auto changeable = level.graph->getVertexPositionArrays();
+                auto& coarse = changeable.getArrays();
+                parallelForBlocks(coarseCount, grain,
+                    [&](int, int begin, int end)
+                    {
+                        for (int c = begin; c < end; ++c)
+                        {
+                            int    weight = 0;
+                            double x = 0., y = 0., z = 0.;
+                            for (int i = level.childOffsets[c]; i < level.childOffsets[c + 1]; ++i)
+                            {
+                                auto const child = level.children[i];
+                                auto const w = fineWeights[child];
+                                auto const p = finePositions->get(child);
+                                weight += w;
+                                x += static_cast<double>(w) * p.x;
+                                y += static_cast<double>(w) * p.y;
+                                z += static_cast<double>(w) * p.z;
+                            }
+
+                            level.vertexWeights[c] = weight;
+                            coarse.set(c, {
+                                static_cast<float>(x / weight),
+                                static_cast<float>(y / weight),
+                                static_cast<float>(z / weight)
+                            });
+                        }
+                    });
+            }
+
+            fineWeights   = level.vertexWeights;
+            vertexCount   = coarseCount;
+            result.levels.push_back(std::move(level));
+            finePositions = &std::as_const(*result.levels.back().graph).getVertexPositionArrays();
+        }
+
+        return result;
+    }
+
+
+    auto computeCoarsening(
+            Graph const&             graph,
+            CoarseningOptions const& options
+        ) -> CoarseningHierarchy
+    {
+        return computeCoarsening(graph.getEdgeListView(), graph.getVertexPositionArrays(), options);
+    }
+
+}
@@ -0,0 +1,254 @@
+/// @file  algorithm_coloring.cpp
+/// @brief Жадная раскраска (естественный порядок, по убыванию степени, smallest-last)
+///        и параллельный алгоритм Джонса -- Плассмана со счётчиками старших соседей.
+#include "../include/algorithm_coloring.hpp"
+#include "../include/algorithm_k_core.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        [[nodiscard]] auto getMaxDegree(CompressedAdjacency const& graph) noexcept
+            -> int
+        {
+            int result = 0;
+            for (int v = 0; v < graph.getVertexCount(); ++v)
+                result = std::max(result, graph.getTargetCount(v));
+            return result;
+        }
+
+
+        // Вершины по убыванию степени (при равных степенях -- по возрастанию номера).
+        [[nodiscard]] auto orderByDegree(CompressedAdjacency const& graph, int maxDegree)
+            -> std::vector<int>
+        {
+            auto const vertexCount = graph.getVertexCount();
+            std::vector<int> start(static_cast<size_t>(maxDegree) + 2);
+            for (int v = 0; v < vertexCount; ++v)
+                ++start[maxDegree - graph.getTargetCount(v) + 1];
+            std::partial_sum(start.begin(), start.end(), start.begin());
+
+            std::vector<int> order(static_cast<size_t>(vertexCount));
+            for (int v = 0; v < vertexCount; ++v)
+                order[start[maxDegree - graph.getTargetCount(v)]++] = v;
+            return order;
+        }
+
+
+        // Собрать списки, заполненные потоками, в один.
+        [[nodiscard]] auto concatenate(std::vector<std::vector<int>>& parts)
+            -> std::vector<int>
+        {
+            size_t total = 0;
+            for (auto const& part: parts)
+                total += part.size();
+
+            std::vector<int> result;
+            result.reserve(total);
+            for (auto& part: parts)
+            {
+                result.insert(result.end(), part.begin(), part.end());
+                part.clear();
+            }
+
+            return result;
+        }
+
+    }
+
+
+    auto GreedyColoring::run(AdjacencyListView const& al)
+        -> Coloring
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+        auto const vertexCount = graph.getVertexCount();
+        auto const maxDegree   = getMaxDegree(graph);
+
+        std::vector<int> order;
+        switch (_order)
+        {
+        case ColoringOrder::LargestFirst:
+            order = orderByDegree(graph, maxDegree);
+            break;
+        case ColoringOrder::SmallestLast:
+            order = computeCoreDecomposition(graph).degeneracyOrder;
+            std::ranges::reverse(order);
+            break;
+        default:
+            order.resize(static_cast<size_t>(vertexCount));
+            std::iota(order.begin(), order.end(), 0);
+            break;
+        }
+
+        Coloring result;
+        auto& colors = result.colors;
+        colors.assign(static_cast<size_t>(vertexCount), -1);
+
+        // usedBy[c] == v: цвет c занят соседом v (цвет вершины не больше её степени).
+        std::vector<int> usedBy(static_cast<size_t>(maxDegree) + 1, -1);
+        auto const notify = hasSubscribers();
+        for (int const v: order)
+        {
+            for (int const u: graph.getTargets(v))
+                if (colors[u] >= 0)
+                    usedBy[colors[u]] = v;
+
+            int color = 0;
+            while (usedBy[color] == v)
+                ++color;
+
+            colors[v] = color;
+            result.colorCount = std::max(result.colorCount, color + 1);
+            if (notify)
+                broadcast(events::VertexColorChanged{ .vertex = v, .color = getPaletteColor(color) });
+        }
+
+        return result;
+    }
+
+
+    auto GreedyColoring::run(Graph const& graph)
+        -> Coloring
+    {
+        return run(graph.getAdjacencyListView());
+    }
+
+
+    auto JonesPlassmannColoring::run(AdjacencyListView const& al)
+        -> Coloring
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+        auto const vertexCount = graph.getVertexCount();
+        auto const maxDegree   = getMaxDegree(graph);
+        auto const seed        = _seed;
+
+        // u раскрашивается раньше v.
+        auto const precedes = [seed](int u, int v) noexcept
+            {
+                auto const pu = getPriority(seed, u);
+                auto const pv = getPriority(seed, v);
+                return pu > pv || (pu == pv && u > v);
+            };
+
+        auto const workerCount = static_cast<size_t>(getWorkerCount());
+        std::vector<std::vector<int>> readyByWorker(workerCount);
+
+        // Число ещё не раскрашенных соседей, которые раскрашиваются раньше.
+        std::vector<int> waiting(static_cast<size_t>(vertexCount));
+        parallelForBlocks(vertexCount, 4096,
+            [&](int worker, int begin, int end)
+            {
+                for (int v = begin; v < end; ++v)
+                {
+                    auto const neighbours = graph.getTargets(v);
+                    waiting[v] = static_cast<int>(std::ranges::count_if(neighbours,
+                        [&](int u) { return precedes(u, v); }));
+                    if (waiting[v] == 0)
+                        readyByWorker[worker].push_back(v);
+                }
+            });
+
+        Coloring result;
+        auto& colors = result.colors;
+        colors.assign(static_cast<size_t>(vertexCount), -1);
+
+        std::vector<std::vector<int>> usedBy(workerCount);
+        auto ready = concatenate(readyByWorker);
+        auto const notify = hasSubscribers();
+        while (!ready.empty())
+        {
+            parallelForBlocks(static_cast<int>(ready.size()), 256,
+                [&](int worker, int begin, int end)
+                {
+                    auto& used = usedBy[worker];
+                    if (used.empty())
+                        used.assign(static_cast<size_t>(maxDegree) + 1, -1);
+
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto const v          = ready[i];
+                        auto const neighbours = graph.getTargets(v);
+                        for (int const u: neighbours)
+                            if (precedes(u, v))
+                                used[colors[u]] = v;
+
+                        int color = 0;
+                        while (used[color] == v)
+                            ++color;
+                        colors[v] = color;
+
+                        // Раунды разделены ожиданием потоков, поэтому цвет v будет виден
+                        // при раскраске u в следующем раунде.
+                        for (int const u: neighbours)
+                        {
+                            if (precedes(v, u)
+                             && std::atomic_ref(waiting[u]).fetch_sub(1, std::memory_order_relaxed) == 1)
+                                readyByWorker[worker].push_back(u);
+                        }
+                    }
+                });
+
+            if (notify)
+            {
+                for (int const v: ready)
+                    broadcast(events::VertexColorChanged{ .vertex = v, .color = getPaletteColor(colors[v]) });
+            }
+
+            ready = concatenate(readyByWorker);
+        }
+
+        for (int const color: colors)
+            result.colorCount = std::max(result.colorCount, color + 1);
+        return result;
+    }
+
+
+    auto JonesPlassmannColoring::run(Graph const& graph)
+        -> Coloring
+    {
+        return run(graph.getAdjacencyListView());
+    }
+
+
+    auto getPaletteColor(int color) noexcept
+        -> events::RGBA
+    {
+        // Тон -- дробная часть color / phi, насыщенность 0.65, яркость 0.95.
+        constexpr double inversePhi = 0.618033988749895;
+        constexpr double saturation = 0.65, value = 0.95;
+
+        auto const hue    = std::fmod(std::abs(color) * inversePhi, 1.) * 6.;
+        auto const sector = static_cast<int>(hue);
+        auto const f      = hue - sector;
+        auto const p      = value * (1. - saturation);
+        auto const q      = value * (1. - saturation * f);
+        auto const t      = value * (1. - saturation * (1. - f));
+
+        double r = value, g = t, b = p;
+        switch (sector)
+        {
+        case 1:  r = q;     g = value; b = p;     break;
+        case 2:  r = p;     g = value; b = t;     break;
+        case 3:  r = p;     g = q;     b = value; break;
+        case 4:  r = t;     g = p;     b = value; break;
+        case 5:  r = value; g = p;     b = q;     break;
+        default: break;
+        }
+
+        auto const toByte = [](double x) noexcept
+            {
+                return static_cast<uint8_t>(std::lround(x * 255.));
+            };
+        return { toByte(r), toByte(g), toByte(b), 255 };
+    }
+
+}
@@ -0,0 +1,576 @@
+/// @file  algorithm_communities.cpp
+/// @brief Распространение меток и метод Лувена на взвешенном неориентированном CSR
+///        с хэш-таблицами потоков для весов соседних сообществ.
+#include "../include/algorithm_communities.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        constexpr int grain = 1024;
+
+
+        // Неориентированный взвешенный граф: каждое ребро (u, v), u != v, записано у обеих вершин,
+        // петли хранятся отдельно. degree[v] -- сумма весов инцидентных рёбер, петля учитывается дважды.
+        struct WeightedGraph
+        {
+            std::vector<int>    offsets;
+            std::vector<int>    targets;
+            std::vector<double> weights;
+            std::vector<double> selfLoops;
+            std::vector<double> degrees;
+            /// Сумма весов всех рёбер и петель (m).
+            double              totalWeight {};
+
+            [[nodiscard]] auto getVertexCount() const noexcept
+                -> int
+            {
+                return static_cast<int>(selfLoops.size());
+            }
+
+            void computeDegrees()
+            {
+                auto const vertexCount = getVertexCount();
+                degrees.resize(static_cast<size_t>(vertexCount));
+                parallelForBlocks(vertexCount, grain,
+                    [this](int, int begin, int end)
+                    {
+                        for (int v = begin; v < end; ++v)
+                        {
+                            degrees[v] = 2. * selfLoops[v];
+                            for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+                                degrees[v] += weights[i];
+                        }
+                    });
+
+                totalWeight = std::reduce(degrees.begin(), degrees.end()) / 2.;
+            }
+        };
+
+
+        [[nodiscard]] auto makeWeightedGraph(EdgeListView const& el, int vertexCount, int weightAttribute)
+            -> std::optional<WeightedGraph>
+        {
+            if (vertexCount < 0)
+                return std::nullopt;
+
+            auto const arcs = el.getArcs();
+            std::span<float const> column;
+            if (weightAttribute >= 0)
+            {
+                if (weightAttribute >= el.getFloatAttributeCount())
+                    return std::nullopt;
+                column = el.getFloatAttributes(weightAttribute);
+                if (column.size() < arcs.size())
+                    return std::nullopt;
+            }
+
+            auto const isValid = [vertexCount](Arc arc) noexcept
+                {
+                    return static_cast<unsigned>(arc.source) < static_cast<unsigned>(vertexCount)
+                        && static_cast<unsigned>(arc.target) < static_cast<unsigned>(vertexCount);
+                };
+
+            WeightedGraph g;
+            g.selfLoops.assign(static_cast<size_t>(vertexCount), 0.);
+            g.offsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                auto const arc = arcs[i];
+                if (!isValid(arc))
+                    continue;
+
+                auto const w = column.empty()? 1.f: column[i];
+                if (!(w >= 0.f))
+                    return std::nullopt;
+
+                if (arc.source == arc.target)
+                {
+                    g.selfLoops[arc.source] += w;
+                    continue;
+                }
+
+                ++g.offsets[arc.source + 1];
+                ++g.offsets[arc.target + 1];
+            }
+
+            std::partial_sum(g.offsets.begin(), g.offsets.end(), g.offsets.begin());
+            g.targets.resize(static_cast<size_t>(g.offsets.back()));
+            g.weights.resize(g.targets.size());
+
+            std::vector<int> position(g.offsets.begin(), g.offsets.end() - 1);
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                auto const arc = arcs[i];
+                if (!isValid(arc) || arc.source == arc.target)
+                    continue;
+
+                auto const w  = column.empty()? 1.: static_cast<double>(column[i]);
+                auto const at = position[arc.source]++;
+                auto const back = position[arc.target]++;
+                g.targets[at]   = arc.target;
+                g.weights[at]   = w;
+                g.targets[back] = arc.source;
+                g.weights[back] = w;
+            }
+
+            g.computeDegrees();
+            return g;
+        }
+
+
+        // Хэш-таблица "сообщество -> вес" с открытой адресацией; очищается за время,
+        // пропорциональное числу добавленных ключей. Своя у каждого потока.
+        class CommunityWeights
+        {
+        public:
+            /// Подготовить таблицу не меньше чем для count ключей и очистить её.
+            void prepare(int count)
+            {
+                clear();
+                auto const capacity = std::bit_ceil(static_cast<size_t>(std::max(count, 8)) * 2);
+                if (_keys.size() < capacity)
+                {
+                    _keys.assign(capacity, -1);
+                    _values.resize(capacity);
+                }
+            }
+
+            void add(int key, double weight) noexcept
+            {
+                auto const slot = _find(key);
+                if (_keys[slot] == -1)
+                {
+                    _keys[slot]   = key;
+                    _values[slot] = 0.;
+                    _used.push_back(slot);
+                }
+
+                _values[slot] += weight;
+            }
+
+            [[nodiscard]] auto get(int key) const noexcept
+                -> double
+            {
+                auto const slot = _find(key);
+                return _keys[slot] == key? _values[slot]: 0.;
+            }
+
+            [[nodiscard]] auto size() const noexcept
+                -> int
+            {
+                return static_cast<int>(_used.size());
+            }
+
+            /// visit(key, weight) в порядке добавления ключей.
+            template <typename Visit>
+            void forEach(Visit visit) const
+            {
+                for (auto const slot: _used)
+                    visit(_keys[slot], _values[slot]);
+            }
+
+            void clear() noexcept
+            {
+                for (auto const slot: _used)
+                    _keys[slot] = -1;
+                _used.clear();
+            }
+
+        private:
+            std::vector<int>    _keys;
+            std::vector<double> _values;
+            std::vector<size_t> _used;
+
+            [[nodiscard]] auto _find(int key) const noexcept
+                -> size_t
+            {
+                auto const mask = _keys.size() - 1;
+                auto hash = static_cast<uint32_t>(key) * 0x9E37'79B9u;
+                auto slot = static_cast<size_t>(hash ^ (hash >> 16)) & mask;
+                while (_keys[slot] != -1 && _keys[slot] != key)
+                    slot = (slot + 1) & mask;
+                return slot;
+            }
+        };
+
+
+        // Порядок меток с равным весом: псевдослучайный, свой для каждой вершины и прохода,
+        // иначе при выборе наименьшей метки малые номера захватывают соседние сообщества.
+        [[nodiscard]] auto getTieKey(int label, uint32_t salt) noexcept
+            -> uint32_t
+        {
+            auto key = (static_cast<uint32_t>(label) ^ salt) * 0x9E37'79B9u;
+            key ^= key >> 15;
+            key *= 0x85EB'CA6Bu;
+            return key ^ (key >> 13);
+        }
+
+
+        // Перенумеровать значения подряд в порядке первого появления; возвращает их число.
+        auto renumber(std::vector<int>& values, int bound)
+            -> int
+        {
+            std::vector<int> number(static_cast<size_t>(bound), -1);
+            int count = 0;
+            for (int& value: values)
+            {
+                if (number[value] == -1)
+                    number[value] = count++;
+                value = number[value];
+            }
+
+            return count;
+        }
+
+
+        [[nodiscard]] auto computeModularity(
+                WeightedGraph const&    g,
+                std::vector<int> const& community,
+                int                     communityCount,
+                double                  resolution
+            ) -> double
+        {
+            if (g.totalWeight <= 0.)
+                return 0.;
+
+            std::vector<double> inside(static_cast<size_t>(communityCount));
+            std::vector<double> total(static_cast<size_t>(communityCount));
+            for (int v = 0; v < g.getVertexCount(); ++v)
+            {
+                auto const c = community[v];
+                total[c]  += g.degrees[v];
+                inside[c] += g.selfLoops[v];
+                for (int i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+                    if (community[g.targets[i]] == c)
+                        inside[c] += g.weights[i] / 2.;
+            }
+
+            auto const m = g.totalWeight;
+            double q = 0.;
+            for (int c = 0; c < communityCount; ++c)
+                q += inside[c] / m - resolution * (total[c] / (2. * m)) * (total[c] / (2. * m));
+            return q;
+        }
+
+
+        // Параллельные локальные перемещения; возвращает true, если хотя бы одна вершина сменила сообщество.
+        bool moveVertices(
+                WeightedGraph const&           g,
+                std::vector<int>&              community,
+                std::vector<CommunityWeights>& tables,
+                LouvainOptions const&          options
+            )
+        {
+            auto const vertexCount = g.getVertexCount();
+            auto const scale       = options.resolution / (2. * g.totalWeight);
+
+            // Суммарные степени и размеры сообществ.
+            std::vector<double> total(g.degrees);
+            std::vector<int>    size(static_cast<size_t>(vertexCount), 1);
+
+            bool anyMoved = false;
+            for (int sweep = 0; sweep < options.maxSweeps; ++sweep)
+            {
+                std::atomic<int> moved {0};
+                parallelForBlocks(vertexCount, grain,
+                    [&](int worker, int begin, int end)
+                    {
+                        auto& weights = tables[worker];
+                        int movedHere = 0;
+                        for (int v = begin; v < end; ++v)
+                        {
+                            auto const own = std::atomic_ref(community[v]).load(std::memory_order_relaxed);
+                            weights.prepare(g.offsets[v + 1] - g.offsets[v]);
+                            for (int i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+                                weights.add(std::atomic_ref(community[g.targets[i]]).load(std::memory_order_relaxed), g.weights[i]);
+
+                            // Выигрыш от v в сообществе c: k(v, c) - resolution * k(v) * total(c) / 2m,
+                            // для своего сообщества total берётся без самой v.
+                            auto const kv   = g.degrees[v];
+                            auto const load = [&total](int c) noexcept
+                                {
+                                    return std::atomic_ref(total[c]).load(std::memory_order_relaxed);
+                                };
+
+                            auto best     = own;
+                            auto bestGain = weights.get(own) - kv * (load(own) - kv) * scale;
+                            weights.forEach([&](int c, double kvc)
+                                {
+                                    if (c == own)
+                                        return;
+                                    auto const gain = kvc - kv * load(c) * scale;
+                                    if (gain > bestGain || (gain == bestGain && best != own && c < best))
+                                    {
+                                        best     = c;
+                                        bestGain = gain;
+                                    }
+                                });
+
+                            if (best == own)
+                                continue;
+
+                            // Две одиночные вершины не должны одновременно перейти друг к другу.
+                            if (std::atomic_ref(size[own]).load(std::memory_order_relaxed) == 1
+                             && std::atomic_ref(size[best]).load(std::memory_order_relaxed) == 1
+                             && best > own)
+                                continue;
+
+                            std::atomic_ref(total[own]).fetch_sub(kv, std::memory_order_relaxed);
+                            std::atomic_ref(total[best]).fetch_add(kv, std::memory_order_relaxed);
+                            std::atomic_ref(size[own]).fetch_sub(1, std::memory_order_relaxed);
+                            std::atomic_ref(size[best]).fetch_add(1, std::memory_order_relaxed);
+                            std::atomic_ref(community[v]).store(best, std::memory_order_relaxed);
+                            ++movedHere;
+                        }
+
+                        moved += movedHere;
+                    });
+
+                if (moved > 0)
+                    anyMoved = true;
+
+                // Последние проходы переставляют единицы вершин и почти не меняют модулярность.
+                if (moved <= vertexCount / 1000)
+                    break;
+            }
+
+            return anyMoved;
+        }
+
+
+        // Граф следующего уровня: сообщество -> вершина, веса рёбер между сообществами складываются,
+        // рёбра внутри сообщества становятся петлёй.
+        [[nodiscard]] auto contract(
+                WeightedGraph const&           g,
+                std::vector<int> const&        community,
+                int                            communityCount,
+                std::vector<CommunityWeights>& tables
+            ) -> WeightedGraph
+        {
+            auto const vertexCount = g.getVertexCount();
+            std::vector<int> memberOffsets(static_cast<size_t>(communityCount) + 1);
+            for (int const c: community)
+                ++memberOffsets[c + 1];
+            std::partial_sum(memberOffsets.begin(), memberOffsets.end(), memberOffsets.begin());
+
+            std::vector<int> members(static_cast<size_t>(vertexCount));
+            {
+                std::vector<int> position(memberOffsets.begin(), memberOffsets.end() - 1);
+                for (int v = 0; v < vertexCount; ++v)
+                    members[position[community[v]]++] = v;
+            }
+
+            WeightedGraph result;
+            result.selfLoops.assign(static_cast<size_t>(communityCount), 0.);
+            result.offsets.assign(static_cast<size_t>(communityCount) + 1, 0);
+
+            // Первый проход считает соседние сообщества, второй записывает их.
+            auto const collect = [&](CommunityWeights& weights, int c) -> double
+                {
+                    int arcCount = 0;
+                    for (int m = memberOffsets[c]; m < memberOffsets[c + 1]; ++m)
+                        arcCount += g.offsets[members[m] + 1] - g.offsets[members[m]];
+                    weights.prepare(arcCount);
+
+                    double self = 0.;
+                    for (int m = memberOffsets[c]; m < memberOffsets[c + 1]; ++m)
+                    {
+                        auto const v = members[m];
+                        self += g.selfLoops[v];
+                        for (int i = g.offsets[v]; i < g.offsets[v + 1]; ++i)
+                        {
+                            auto const d = community[g.targets[i]];
+                            if (d == c)
+                                self += g.weights[i] / 2.;
+                            else
+                                weights.add(d, g.weights[i]);
+                        }
+                    }
+
+                    return self;
+                };
+
+            parallelForBlocks(communityCount, 256,
+                [&](int worker, int begin, int end)
+                {
+                    for (int c = begin; c < end; ++c)
+                    {
+                        result.selfLoops[c]   = collect(tables[worker], c);
+                        result.offsets[c + 1] = tables[worker].size();
+                    }
+                });
+
+            std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+            result.targets.resize(static_cast<size_t>(result.offsets.back()));
+            result.weights.resize(result.targets.size());
+            parallelForBlocks(communityCount, 256,
+                [&](int worker, int begin, int end)
+                {
+                    for (int c = begin; c < end; ++c)
+                    {
+                        collect(tables[worker], c);
+                        auto at = result.offsets[c];
+                        tables[worker].forEach([&](int d, double w)
+                            {
+                                result.targets[at] = d;
+                                result.weights[at] = w;
+                                ++at;
+                            });
+                    }
+                });
+
+            result.computeDegrees();
+            return result;
+        }
+
+    }
+
+
+    auto computeLabelPropagation(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute,
+            int                 maxIterations
+        ) -> Communities
+    {
+        auto const g = makeWeightedGraph(el, vertexCount, weightAttribute);
+        if (!g)
+            return {};
+
+        Communities result;
+        auto& labels = result.communities;
+        labels.resize(static_cast<size_t>(vertexCount));
+        std::iota(labels.begin(), labels.end(), 0);
+
+        std::vector<CommunityWeights> tables(static_cast<size_t>(getWorkerCount()));
+        for (int iteration = 0; iteration < maxIterations; ++iteration)
+        {
+            std::atomic<int> changed {0};
+            parallelForBlocks(vertexCount, grain,
+                [&](int worker, int begin, int end)
+                {
+                    auto& weights = tables[worker];
+                    int changedHere = 0;
+                    for (int v = begin; v < end; ++v)
+                    {
+                        weights.prepare(g->offsets[v + 1] - g->offsets[v]);
+                        for (int i = g->offsets[v]; i < g->offsets[v + 1]; ++i)
+                            weights.add(std::atomic_ref(labels[g->targets[i]]).load(std::memory_order_relaxed), g->weights[i]);
+
+                        auto const own  = std::atomic_ref(labels[v]).load(std::memory_order_relaxed);
+                        auto const salt = static_cast<uint32_t>(v) * 0x0100'0193u + static_cast<uint32_t>(iteration);
+                        auto best       = own;
+                        auto bestWeight = weights.get(own);
+                        weights.forEach([&](int label, double weight)
+                            {
+                                if (weight > bestWeight
+                                 || (weight == bestWeight && best != own && getTieKey(label, salt) < getTieKey(best, salt)))
+                                {
+                                    best       = label;
+                                    bestWeight = weight;
+                                }
+                            });
+
+                        if (best != own)
+                        {
+                            std::atomic_ref(labels[v]).store(best, std::memory_order_relaxed);
+                            ++changedHere;
+                        }
+                    }
+
+                    changed += changedHere;
+                });
+
+            if (changed <= vertexCount / 1000)
+                break;
+        }
+
+        result.communityCount = renumber(labels, vertexCount);
+        result.modularity     = static_cast<float>(computeModularity(*g, labels, result.communityCount, 1.));
+        return result;
+    }
+
+
+    auto computeLabelPropagation(
+            Graph const& graph,
+            int          weightAttribute,
+            int          maxIterations
+        ) -> Communities
+    {
+        return computeLabelPropagation(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute, maxIterations);
+    }
+
+
+    auto computeLouvain(
+            EdgeListView const&   el,
+            int                   vertexCount,
+            int                   weightAttribute,
+            LouvainOptions const& options
+        ) -> Communities
+    {
+        auto g = makeWeightedGraph(el, vertexCount, weightAttribute);
+        if (!g || !(options.resolution > 0.f))
+            return {};
+
+        Communities result;
+        auto& assignment = result.communities;
+        assignment.resize(static_cast<size_t>(vertexCount));
+        std::iota(assignment.begin(), assignment.end(), 0);
+        result.communityCount = vertexCount;
+
+        // Сжатие сохраняет модулярность, поэтому её достаточно считать на текущем уровне.
+        auto level = std::move(*g);
+        std::vector<CommunityWeights> tables(static_cast<size_t>(getWorkerCount()));
+        auto modularity = computeModularity(level, assignment, vertexCount, options.resolution);
+
+        for (int depth = 0; depth < options.maxLevels && level.totalWeight > 0.; ++depth)
+        {
+            auto const levelVertexCount = level.getVertexCount();
+            std::vector<int> community(static_cast<size_t>(levelVertexCount));
+            std::iota(community.begin(), community.end(), 0);
+            if (!moveVertices(level, community, tables, options))
+                break;
+
+            auto const communityCount = renumber(community, levelVertexCount);
+            auto const improved       = computeModularity(level, community, communityCount, options.resolution);
+            if (improved <= modularity)
+                break;
+
+            auto const gain = improved - modularity;
+            for (int& c: assignment)
+                c = community[c];
+            result.communityCount = communityCount;
+            modularity = improved;
+
+            if (communityCount == levelVertexCount || gain < options.tolerance)
+                break;
+            level = contract(level, community, communityCount, tables);
+        }
+
+        result.communityCount = renumber(assignment, result.communityCount);
+        result.modularity     = static_cast<float>(modularity);
+        return result;
+    }
+
+
+    auto computeLouvain(
+            Graph const&          graph,
+            int                   weightAttribute,
+            LouvainOptions const& options
+        ) -> Communities
+    {
+        return computeLouvain(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute, options);
+    }
+
+}
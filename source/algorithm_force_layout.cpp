@@ -0,0 +1,323 @@
+/// @file  algorithm_force_layout.cpp
+/// @brief Силовая укладка: октодерево Барнса -- Хата (перестраивается на каждой итерации),
+///        параллельный расчёт сил по вершинам на координатах в виде структуры массивов.
+#include "../include/algorithm_force_layout.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        // Октодерево по набору точек: у внутренней ячейки до 8 непустых детей, лежащих подряд,
+        // лист хранит отрезок [begin, end) перестановки точек. Координаты точек копируются
+        // в порядке перестановки, поэтому перебор точек листа идёт по непрерывным массивам.
+        class Octree
+        {
+        public:
+            void build(VertexPositionArrays const& points)
+            {
+                auto const count = points.size();
+                _cells.clear();
+                _order.resize(static_cast<size_t>(count));
+                _buffer.resize(static_cast<size_t>(count));
+                for (int i = 0; i < count; ++i)
+                    _order[i] = i;
+
+                if (count == 0)
+                    return;
+
+                auto const [low, high] = points.getBounds();
+                auto const half = std::max({ high.x - low.x, high.y - low.y, high.z - low.z, 1e-6f }) / 2.f;
+                XYZ const center { (low.x + high.x) / 2.f, (low.y + high.y) / 2.f, (low.z + high.z) / 2.f };
+                _cells.emplace_back();
+                _build(points, 0, 0, count, center, half, 0);
+
+                _sorted.resize(count);
+                auto const x = points.getX(), y = points.getY(), z = points.getZ();
+                auto const sx = _sorted.getX(), sy = _sorted.getY(), sz = _sorted.getZ();
+                for (int i = 0; i < count; ++i)
+                {
+                    sx[i] = x[_order[i]];
+                    sy[i] = y[_order[i]];
+                    sz[i] = z[_order[i]];
+                }
+            }
+
+            /// Сила отталкивания (k2 / d на единицу массы) на точку p.
+            /// Совпадающие с p точки (в том числе она сама) не учитываются.
+            [[nodiscard]] auto getRepulsion(XYZ const& p, float k2, float theta2) const noexcept
+                -> XYZ
+            {
+                XYZ force {};
+                if (_cells.empty())
+                    return force;
+
+                auto const push = [&](float x, float y, float z, float mass) noexcept
+                    {
+                        auto const dx = p.x - x, dy = p.y - y, dz = p.z - z;
+                        auto const d2 = dx * dx + dy * dy + dz * dz;
+                        auto const f  = d2 > 1e-12f? k2 * mass / d2: 0.f;
+                        force.x += dx * f;
+                        force.y += dy * f;
+                        force.z += dz * f;
+                    };
+
+                auto const sx = _sorted.getX(), sy = _sorted.getY(), sz = _sorted.getZ();
+                std::array<int, 8 * maxDepth + 8> stack;
+                int top = 0;
+                stack[top++] = 0;
+                while (top > 0)
+                {
+                    auto const& cell = _cells[stack[--top]];
+                    if (cell.firstChild < 0)
+                    {
+                        for (int i = cell.begin; i < cell.end; ++i)
+                            push(sx[i], sy[i], sz[i], 1.f);
+                        continue;
+                    }
+
+                    // Ячейка, содержащая саму точку, всегда раскрывается.
+                    auto const dx = p.x - cell.massCenter.x, dy = p.y - cell.massCenter.y, dz = p.z - cell.massCenter.z;
+                    auto const inside = std::abs(p.x - cell.center.x) <= cell.half
+                                     && std::abs(p.y - cell.center.y) <= cell.half
+                                     && std::abs(p.z - cell.center.z) <= cell.half;
+                    auto const size = 2.f * cell.half;
+                    if (!inside && size * size < theta2 * (dx * dx + dy * dy + dz * dz))
+                    {
+                        push(cell.massCenter.x, cell.massCenter.y, cell.massCenter.z, cell.mass);
+                        continue;
+                    }
+
+                    for (int c = cell.firstChild + cell.childCount - 1; c >= cell.firstChild; --c)
+                        stack[top++] = c;
+                }
+
+                return force;
+            }
+
+        private:
+            static constexpr int maxDepth  = 24;
+            static constexpr int leafSize  = 8;
+
+            struct Cell
+            {
+                XYZ   center;
+                XYZ   massCenter;
+                float half;
+                float mass;
+                int   firstChild = -1;
+                int   childCount = 0;
+                int   begin;
+                int   end;
+            };
+
+            std::vector<Cell>    _cells;
+            std::vector<int>     _order;
+            std::vector<int>     _buffer;
+            VertexPositionArrays _sorted;
+
+            void _build(VertexPositionArrays const& points, int index, int begin, int end, XYZ center, float half, int depth)
+            {
+                auto const x = points.getX(), y = points.getY(), z = points.getZ();
+                Cell cell { .center = center, .massCenter = {}, .half = half,
+                            .mass = static_cast<float>(end - begin), .begin = begin, .end = end };
+
+                if (end - begin <= leafSize || depth == maxDepth)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        cell.massCenter.x += x[_order[i]];
+                        cell.massCenter.y += y[_order[i]];
+                        cell.massCenter.z += z[_order[i]];
+                    }
+
+                    cell.massCenter = { cell.massCenter.x / cell.mass, cell.massCenter.y / cell.mass, cell.massCenter.z / cell.mass };
+                    _cells[index] = cell;
+                    return;
+                }
+
+                // Распределение точек по октантам подсчётом.
+                auto const getOctant = [&](int point) noexcept
+                    {
+                        return (x[point] >= center.x? 1: 0) | (y[point] >= center.y? 2: 0) | (z[point] >= center.z? 4: 0);
+                    };
+
+                std::array<int, 9> start {};
+                for (int i = begin; i < end; ++i)
+                    ++start[getOctant(_order[i]) + 1];
+                for (int o = 0; o < 8; ++o)
+                    start[o + 1] += start[o];
+
+                auto position = start;
+                for (int i = begin; i < end; ++i)
+                {
+                    auto const point = _order[i];
+                    _buffer[begin + position[getOctant(point)]++] = point;
+                }
+                std::copy(_buffer.begin() + begin, _buffer.begin() + end, _order.begin() + begin);
+
+                cell.firstChild = static_cast<int>(_cells.size());
+                for (int o = 0; o < 8; ++o)
+                    cell.childCount += start[o + 1] > start[o];
+                _cells[index] = cell;
+                _cells.resize(_cells.size() + static_cast<size_t>(cell.childCount));
+
+                auto const childHalf = half / 2.f;
+                auto child = cell.firstChild;
+                XYZ sum {};
+                for (int o = 0; o < 8; ++o)
+                {
+                    if (start[o + 1] == start[o])
+                        continue;
+
+                    XYZ const childCenter {
+                            center.x + ((o & 1)? childHalf: -childHalf),
+                            center.y + ((o & 2)? childHalf: -childHalf),
+                            center.z + ((o & 4)? childHalf: -childHalf)
+                        };
+                    _build(points, child, begin + start[o], begin + start[o + 1], childCenter, childHalf, depth + 1);
+
+                    auto const& built = _cells[child];
+                    sum.x += built.massCenter.x * built.mass;
+                    sum.y += built.massCenter.y * built.mass;
+                    sum.z += built.massCenter.z * built.mass;
+                    ++child;
+                }
+
+                _cells[index].massCenter = { sum.x / cell.mass, sum.y / cell.mass, sum.z / cell.mass };
+            }
+        };
+
+
+        // Случайное размещение в кубе со стороной k * V^(1/3), если все координаты нулевые.
+        void scatterIfUnplaced(VertexPositionArrays& positions, float side, uint64_t seed)
+        {
+            auto const isZero = [](float value) { return value == 0.f; };
+            auto const unplaced = std::ranges::all_of(positions.getX(), isZero)
+                               && std::ranges::all_of(positions.getY(), isZero)
+                               && std::ranges::all_of(positions.getZ(), isZero);
+            if (!unplaced)
+                return;
+
+            std::mt19937_64 random(seed);
+            std::uniform_real_distribution<float> coordinate(-side / 2.f, side / 2.f);
+            for (int v = 0; v < positions.size(); ++v)
+            {
+                auto const x = coordinate(random);
+                auto const y = coordinate(random);
+                positions.set(v, { x, y, coordinate(random) });
+            }
+        }
+
+    }
+
+
+    bool ForceDirectedLayout::run(AdjacencyListView const& al, VertexPositionArrays& positions)
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+        auto const vertexCount = graph.getVertexCount();
+        if (positions.size() != vertexCount)
+            return false;
+
+        auto const k      = _options.idealDistance;
+        auto const k2     = k * k;
+        auto const theta2 = _options.theta * _options.theta;
+        auto const side   = k * std::cbrt(static_cast<float>(std::max(vertexCount, 1)));
+        scatterIfUnplaced(positions, side, _options.seed);
+
+        auto const initialTemperature = _options.initialTemperature > 0.f? _options.initialTemperature: side / 2.f;
+        auto const gravity = _options.gravity;
+        auto const notify  = hasSubscribers();
+
+        auto const x = positions.getX(), y = positions.getY(), z = positions.getZ();
+        VertexPositionArrays forces(vertexCount);
+        auto const fx = forces.getX(), fy = forces.getY(), fz = forces.getZ();
+
+        Octree tree;
+        for (int iteration = 0; iteration < _options.iterations; ++iteration)
+        {
+            auto const temperature = initialTemperature * (1.f - static_cast<float>(iteration) / _options.iterations);
+            tree.build(positions);
+
+            parallelForBlocks(vertexCount, 256,
+                [&](int, int begin, int end)
+                {
+                    for (int v = begin; v < end; ++v)
+                    {
+                        auto force = tree.getRepulsion({ x[v], y[v], z[v] }, k2, theta2);
+                        for (int const u: graph.getTargets(v))
+                        {
+                            auto const dx = x[v] - x[u], dy = y[v] - y[u], dz = z[v] - z[u];
+                            auto const f  = std::sqrt(dx * dx + dy * dy + dz * dz) / k;
+                            force.x -= dx * f;
+                            force.y -= dy * f;
+                            force.z -= dz * f;
+                        }
+
+                        fx[v] = force.x;
+                        fy[v] = force.y;
+                        fz[v] = force.z;
+                    }
+                });
+
+            // Притяжение к центру и ограничение смещения температурой -- поэлементно по массивам;
+            // смещения применяются после расчёта всех сил, чтобы потоки читали одни и те же координаты.
+            parallelForBlocks(vertexCount, 4096,
+                [&](int, int begin, int end)
+                {
+                    for (int v = begin; v < end; ++v)
+                    {
+                        auto const gx = fx[v] - x[v] * gravity;
+                        auto const gy = fy[v] - y[v] * gravity;
+                        auto const gz = fz[v] - z[v] * gravity;
+                        auto const length = std::sqrt(gx * gx + gy * gy + gz * gz);
+                        auto const scale  = length > temperature? temperature / length: 1.f;
+                        x[v] += gx * scale;
+                        y[v] += gy * scale;
+                        z[v] += gz * scale;
+                    }
+                });
+
+            if (notify)
+            {
+                for (int v = 0; v < vertexCount; ++v)
+                    broadcast(events::VertexPositionChanged{ .xyz = { x[v], y[v], z[v] }, .vertex = v });
+            }
+        }
+
+        return true;
+    }
+
+
+    bool ForceDirectedLayout::run(AdjacencyListView const& al, std::span<XYZ> positions)
+    {
+        if (static_cast<int>(positions.size()) != al.getVertexCount())
+            return false;
+
+        VertexPositionArrays arrays(static_cast<int>(positions.size()));
+        arrays.copyFrom(positions);
+        if (!run(al, arrays))
+            return false;
+
+        arrays.copyTo(positions);
+        return true;
+    }
+
+
+    bool ForceDirectedLayout::run(Graph& graph)
+    {
+        auto const& al = graph.getAdjacencyListView();
+        auto positions = graph.getVertexPositionArrays();
+        return run(al, positions.getArrays());
+    }
+
+}
@@ -0,0 +1,169 @@
+/// @file  algorithm_k_core.cpp
+/// @brief k-ядра: корзины Батагеля -- Заверсника и параллельное отслаивание по уровням.
+#include "../include/algorithm_k_core.hpp"
+#include "../include/attribute_columns.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace gravis24::algorithm
+{
+
+    auto computeCoreDecomposition(AdjacencyListView const& al)
+        -> CoreDecomposition
+    {
+        return computeCoreDecomposition(CompressedAdjacency::fromAdjacencyList(al).symmetrized());
+    }
+
+
+    auto computeCoreDecomposition(CompressedAdjacency const& undirected)
+        -> CoreDecomposition
+    {
+        auto const vertexCount = undirected.getVertexCount();
+        CoreDecomposition result;
+        auto& degree = result.coreNumbers;
+        degree.resize(static_cast<size_t>(vertexCount));
+
+        int maxDegree = 0;
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            degree[v] = undirected.getTargetCount(v);
+            maxDegree = std::max(maxDegree, degree[v]);
+        }
+
+        // bin[d] -- начало корзины степени d в vert.
+        std::vector<int> bin(static_cast<size_t>(maxDegree) + 1);
+        for (int v = 0; v < vertexCount; ++v)
+            ++bin[degree[v]];
+        for (int d = 0, start = 0; d <= maxDegree; ++d)
+            start += std::exchange(bin[d], start);
+
+        // vert -- вершины по неубыванию текущей степени, pos -- обратная перестановка.
+        auto& vert = result.degeneracyOrder;
+        vert.resize(static_cast<size_t>(vertexCount));
+        std::vector<int> pos(static_cast<size_t>(vertexCount));
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            pos[v] = bin[degree[v]]++;
+            vert[pos[v]] = v;
+        }
+
+        for (int d = maxDegree; d > 0; --d)
+            bin[d] = bin[d - 1];
+        bin[0] = 0;
+
+        // При удалении vert[i] его текущая степень становится номером ядра.
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            auto const v = vert[i];
+            result.degeneracy = std::max(result.degeneracy, degree[v]);
+            for (int const u: undirected.getTargets(v))
+            {
+                if (degree[u] <= degree[v])
+                    continue;
+
+                // Переместить u в начало его корзины и сдвинуть границу корзины.
+                auto const du = degree[u];
+                auto const pu = pos[u];
+                auto const pw = bin[du];
+                auto const w  = vert[pw];
+                if (u != w)
+                {
+                    std::swap(vert[pu], vert[pw]);
+                    pos[u] = pw;
+                    pos[w] = pu;
+                }
+
+                ++bin[du];
+                --degree[u];
+            }
+        }
+
+        return result;
+    }
+
+
+    auto computeCoreDecomposition(EditableAdjacencyList& al, int coreAttribute)
+        -> CoreDecomposition
+    {
+        if (static_cast<unsigned>(coreAttribute) >= static_cast<unsigned>(al.getVertexIntAttributeCount()))
+            return {};
+
+        auto result = computeCoreDecomposition(static_cast<AdjacencyListView const&>(al));
+        storeVertexIntAttributes(al, coreAttribute, result.coreNumbers);
+        return result;
+    }
+
+
+    auto computeCoreDecompositionParallel(AdjacencyListView const& al)
+        -> CoreDecomposition
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+        auto const vertexCount = graph.getVertexCount();
+
+        CoreDecomposition result;
+        auto& core  = result.coreNumbers;
+        auto& order = result.degeneracyOrder;
+        core.assign(static_cast<size_t>(vertexCount), -1);
+        order.reserve(static_cast<size_t>(vertexCount));
+
+        std::vector<int> degree(static_cast<size_t>(vertexCount));
+        std::vector<int> remaining(static_cast<size_t>(vertexCount));
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            degree[v]    = graph.getTargetCount(v);
+            remaining[v] = v;
+        }
+
+        std::vector<std::vector<int>> nextByWorker(static_cast<size_t>(getWorkerCount()));
+        std::vector<int> wave;
+        while (!remaining.empty())
+        {
+            // Пустые уровни пропускаются: k -- наименьшая степень среди оставшихся.
+            auto k = degree[remaining.front()];
+            for (int const v: remaining)
+                k = std::min(k, degree[v]);
+
+            wave.clear();
+            for (int const v: remaining)
+                if (degree[v] <= k)
+                    wave.push_back(v);
+
+            while (!wave.empty())
+            {
+                // Степень соседа, ставшая равной k (ровно один раз), переводит его в следующую волну.
+                // Степени уже удалённых вершин не больше k и дальше только уменьшаются.
+                parallelForBlocks(static_cast<int>(wave.size()), 256,
+                    [&](int worker, int begin, int end)
+                    {
+                        for (int i = begin; i < end; ++i)
+                        {
+                            auto const v = wave[i];
+                            core[v] = k;
+                            for (int const u: graph.getTargets(v))
+                                if (std::atomic_ref(degree[u]).fetch_sub(1, std::memory_order_relaxed) == k + 1)
+                                    nextByWorker[worker].push_back(u);
+                        }
+                    });
+
+                order.insert(order.end(), wave.begin(), wave.end());
+                wave.clear();
+                for (auto& next: nextByWorker)
+                {
+                    wave.insert(wave.end(), next.begin(), next.end());
+                    next.clear();
+                }
+
+                std::ranges::sort(wave);
+            }
+
+            result.degeneracy = k;
+            std::erase_if(remaining, [&core](int v) { return core[v] != -1; });
+        }
+
+        return result;
+    }
+
+}
@@ -0,0 +1,405 @@
+/// @file  algorithm_matching.cpp
+/// @brief Жадные паросочетания (по порядку вершин, Карп -- Сипсер), параллельные "рукопожатия"
+///        и Хопкрофт -- Карп с послойным обходом в ширину и итеративным поиском в глубину.
+#include "../include/algorithm_matching.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        void match(std::vector<int>& mates, int u, int v) noexcept
+        {
+            mates[u] = v;
+            mates[v] = u;
+        }
+
+
+        [[nodiscard]] auto getMatchingSize(std::vector<int> const& mates) noexcept
+            -> int
+        {
+            int size = 0;
+            for (int v = 0; v < static_cast<int>(mates.size()); ++v)
+                size += mates[v] > v;
+            return size;
+        }
+
+
+        [[nodiscard]] auto matchGreedily(CompressedAdjacency const& graph)
+            -> std::vector<int>
+        {
+            std::vector<int> mates(static_cast<size_t>(graph.getVertexCount()), -1);
+            for (int u = 0; u < graph.getVertexCount(); ++u)
+            {
+                if (mates[u] != -1)
+                    continue;
+
+                for (int const v: graph.getTargets(u))
+                {
+                    if (mates[v] == -1)
+                    {
+                        match(mates, u, v);
+                        break;
+                    }
+                }
+            }
+
+            return mates;
+        }
+
+
+        [[nodiscard]] auto matchKarpSipser(CompressedAdjacency const& graph)
+            -> std::vector<int>
+        {
+            auto const vertexCount = graph.getVertexCount();
+            std::vector<int> mates(static_cast<size_t>(vertexCount), -1);
+
+            // Число свободных соседей; вершины, у которых оно стало равно 1.
+            std::vector<int> freeDegree(static_cast<size_t>(vertexCount));
+            std::vector<int> single;
+            for (int v = 0; v < vertexCount; ++v)
+            {
+                freeDegree[v] = graph.getTargetCount(v);
+                if (freeDegree[v] == 1)
+                    single.push_back(v);
+            }
+
+            auto const take = [&](int u, int v)
+                {
+                    match(mates, u, v);
+                    for (int const x: { u, v })
+                        for (int const w: graph.getTargets(x))
+                            if (mates[w] == -1 && --freeDegree[w] == 1)
+                                single.push_back(w);
+                };
+
+            int next = 0;
+            while (true)
+            {
+                while (!single.empty())
+                {
+                    auto const u = single.back();
+                    single.pop_back();
+                    if (mates[u] != -1 || freeDegree[u] != 1)
+                        continue;
+
+                    for (int const v: graph.getTargets(u))
+                    {
+                        if (mates[v] == -1)
+                        {
+                            take(u, v);
+                            break;
+                        }
+                    }
+                }
+
+                while (next < vertexCount && (mates[next] != -1 || freeDegree[next] == 0))
+                    ++next;
+                if (next == vertexCount)
+                    break;
+
+                int best = -1;
+                for (int const v: graph.getTargets(next))
+                    if (mates[v] == -1 && (best == -1 || freeDegree[v] < freeDegree[best]))
+                        best = v;
+                take(next, best);
+            }
+
+            return mates;
+        }
+
+
+        [[nodiscard]] auto matchHeuristically(CompressedAdjacency const& graph, MatchingHeuristic heuristic)
+            -> std::vector<int>
+        {
+            return heuristic == MatchingHeuristic::Greedy? matchGreedily(graph): matchKarpSipser(graph);
+        }
+
+
+        // Раскраска в два цвета обходом в ширину: 0 -- левая доля, 1 -- правая.
+        // Пустой результат, если есть нечётный цикл.
+        [[nodiscard]] auto splitBipartite(CompressedAdjacency const& graph)
+            -> std::vector<char>
+        {
+            auto const vertexCount = graph.getVertexCount();
+            std::vector<char> side(static_cast<size_t>(vertexCount), -1);
+            std::vector<int>  queue;
+            queue.reserve(static_cast<size_t>(vertexCount));
+            for (int root = 0; root < vertexCount; ++root)
+            {
+                if (side[root] != -1)
+                    continue;
+
+                side[root] = 0;
+                queue.push_back(root);
+                for (size_t head = queue.size() - 1; head < queue.size(); ++head)
+                {
+                    auto const u = queue[head];
+                    for (int const v: graph.getTargets(u))
+                    {
+                        if (side[v] == -1)
+                        {
+                            side[v] = static_cast<char>(1 - side[u]);
+                            queue.push_back(v);
+                        }
+                        else if (side[v] == side[u])
+                        {
+                            return {};
+                        }
+                    }
+                }
+            }
+
+            return side;
+        }
+
+    }
+
+
+    auto GreedyMatching::run(AdjacencyListView const& al)
+        -> Matching
+    {
+        auto const graph = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+
+        Matching result;
+        result.mates = matchHeuristically(graph, _heuristic);
+        result.size  = getMatchingSize(result.mates);
+        if (hasSubscribers())
+        {
+            for (int u = 0; u < graph.getVertexCount(); ++u)
+                if (result.mates[u] > u)
+                    broadcast(events::ArcIsMatched{ .arc = { u, result.mates[u] } });
+        }
+
+        return result;
+    }
+
+
+    auto GreedyMatching::run(Graph const& graph)
+        -> Matching
+    {
+        return run(graph.getAdjacencyListView());
+    }
+
+
+    auto ParallelMatching::run(AdjacencyListView const& al)
+        -> Matching
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+        auto const vertexCount = graph.getVertexCount();
+        auto const seed        = _seed;
+
+        Matching result;
+        auto& mates = result.mates;
+        mates.assign(static_cast<size_t>(vertexCount), -1);
+
+        // Свободные вершины, у которых в начале раунда были свободные соседи.
+        // Вершина может выбрать только такую же вершину, поэтому choice[choice[u]] актуален.
+        std::vector<int> active;
+        for (int v = 0; v < vertexCount; ++v)
+            if (graph.getTargetCount(v) > 0)
+                active.push_back(v);
+
+        std::vector<int> choice(static_cast<size_t>(vertexCount), -1);
+        auto const notify = hasSubscribers();
+        while (!active.empty())
+        {
+            auto const activeCount = static_cast<int>(active.size());
+            parallelForBlocks(activeCount, 1024,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto const u = active[i];
+                        int      best         = -1;
+                        uint64_t bestPriority = 0;
+                        for (int const v: graph.getTargets(u))
+                        {
+                            if (mates[v] != -1)
+                                continue;
+
+                            auto const priority = getPriority(seed, v);
+                            if (best == -1 || priority > bestPriority || (priority == bestPriority && v > best))
+                            {
+                                best         = v;
+                                bestPriority = priority;
+                            }
+                        }
+
+                        choice[u] = best;
+                    }
+                });
+
+            // Каждая вершина записывает только свою пару, поэтому раунд свободен от гонок.
+            parallelForBlocks(activeCount, 4096,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto const u = active[i];
+                        auto const c = choice[u];
+                        if (c != -1 && choice[c] == u)
+                            mates[u] = c;
+                    }
+                });
+
+            if (notify)
+            {
+                for (int const u: active)
+                    if (mates[u] > u)
+                        broadcast(events::ArcIsMatched{ .arc = { u, mates[u] } });
+            }
+
+            std::erase_if(active, [&](int u) { return mates[u] != -1 || choice[u] == -1; });
+        }
+
+        result.size = getMatchingSize(mates);
+        return result;
+    }
+
+
+    auto ParallelMatching::run(Graph const& graph)
+        -> Matching
+    {
+        return run(graph.getAdjacencyListView());
+    }
+
+
+    auto HopcroftKarp::run(AdjacencyListView const& al)
+        -> Matching
+    {
+        auto const graph       = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+        auto const vertexCount = graph.getVertexCount();
+        auto const side        = splitBipartite(graph);
+        if (static_cast<int>(side.size()) != vertexCount)
+            return {};
+
+        Matching result;
+        auto& mates = result.mates;
+        mates = matchHeuristically(graph, _initialization);
+
+        std::vector<int> left;
+        for (int v = 0; v < vertexCount; ++v)
+            if (side[v] == 0 && graph.getTargetCount(v) > 0)
+                left.push_back(v);
+
+        constexpr auto unreached = std::numeric_limits<int>::max();
+        std::vector<int> layer(static_cast<size_t>(vertexCount), unreached);
+        std::vector<int> nextArc(static_cast<size_t>(vertexCount));
+        std::vector<int> queue;
+        std::vector<int> path;
+        queue.reserve(left.size());
+
+        while (true)
+        {
+            // Слои левых вершин: свободные -- 0, далее через ребро не из паросочетания
+            // и обратно по ребру паросочетания. freeLayer -- слой ближайших свободных правых.
+            queue.clear();
+            for (int const u: left)
+            {
+                layer[u] = mates[u] == -1? 0: unreached;
+                if (layer[u] == 0)
+                    queue.push_back(u);
+            }
+
+            auto freeLayer = unreached;
+            for (size_t head = 0; head < queue.size(); ++head)
+            {
+                auto const u = queue[head];
+                if (layer[u] >= freeLayer)
+                    break;
+
+                for (int const v: graph.getTargets(u))
+                {
+                    auto const w = mates[v];
+                    if (w == -1)
+                        freeLayer = layer[u];
+                    else if (layer[w] == unreached)
+                    {
+                        layer[w] = layer[u] + 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+
+            if (freeLayer == unreached)
+                break;
+
+            for (int const u: left)
+                nextArc[u] = 0;
+
+            // Поиск в глубину по слоям; path -- левые вершины текущего пути, для каждой
+            // nextArc указывает на ребро к следующей. Тупиковые вершины выбывают до конца фазы.
+            for (int const root: left)
+            {
+                if (layer[root] != 0 || mates[root] != -1)
+                    continue;
+
+                path.assign(1, root);
+                while (!path.empty())
+                {
+                    auto const u       = path.back();
+                    auto const targets = graph.getTargets(u);
+                    bool advanced = false, found = false;
+                    for (; nextArc[u] < static_cast<int>(targets.size()); ++nextArc[u])
+                    {
+                        auto const w = mates[targets[nextArc[u]]];
+                        if (w == -1)
+                        {
+                            if (layer[u] == freeLayer)
+                            {
+                                found = true;
+                                break;
+                            }
+                        }
+                        else if (layer[u] < freeLayer && layer[w] == layer[u] + 1)
+                        {
+                            path.push_back(w);
+                            advanced = true;
+                            break;
+                        }
+                    }
+
+                    if (found)
+                    {
+                        for (int const x: path)
+                            match(mates, x, graph.getTargets(x)[nextArc[x]]);
+                        break;
+                    }
+
+                    if (!advanced)
+                    {
+                        layer[u] = unreached;
+                        path.pop_back();
+                        if (!path.empty())
+                            ++nextArc[path.back()];
+                    }
+                }
+            }
+        }
+
+        result.size = getMatchingSize(mates);
+        if (hasSubscribers())
+        {
+            for (int const u: left)
+                if (mates[u] != -1)
+                    broadcast(events::ArcIsMatched{ .arc = { u, mates[u] } });
+        }
+
+        return result;
+    }
+
+
+    auto HopcroftKarp::run(Graph const& graph)
+        -> Matching
+    {
+        return run(graph.getAdjacencyListView());
+    }
+
+}
@@ -0,0 +1,551 @@
+/// @file  algorithm_max_flow.cpp
+/// @brief Проталкивание предпотока (highest-label, gap, global relabel) на остаточном CSR
+///        с парными обратными дугами.
+#include "../include/algorithm_max_flow.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <doctest/doctest.h>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        // Остаточный граф: дуга (u, v) исходного списка даёт прямую дугу в окрестности u
+        // и обратную (нулевой ёмкости) в окрестности v; mates связывает их взаимно.
+        template <typename Flow>
+        struct ResidualGraph
+        {
+            std::vector<int>  offsets;
+            std::vector<int>  heads;
+            std::vector<int>  mates;
+            std::vector<Flow> residual;
+            /// Позиция прямой дуги для каждой дуги списка или -1.
+            std::vector<int>  forward;
+
+            [[nodiscard]] auto getVertexCount() const noexcept
+                -> int
+            {
+                return static_cast<int>(offsets.size()) - 1;
+            }
+        };
+
+
+        template <typename Flow, typename Capacity>
+        [[nodiscard]] auto makeResidualGraph(
+                std::span<Arc const>      arcs,
+                int                       vertexCount,
+                std::span<Capacity const> capacities
+            ) -> ResidualGraph<Flow>
+        {
+            auto const isEdge = [vertexCount](Arc arc) noexcept
+                {
+                    return static_cast<unsigned>(arc.source) < static_cast<unsigned>(vertexCount)
+                        && static_cast<unsigned>(arc.target) < static_cast<unsigned>(vertexCount)
+                        && arc.source != arc.target;
+                };
+
+            ResidualGraph<Flow> g;
+            auto& offsets = g.offsets;
+            offsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+            for (auto const arc: arcs)
+            {
+                if (isEdge(arc))
+                {
+                    ++offsets[arc.source + 1];
+                    ++offsets[arc.target + 1];
+                }
+            }
+
+            for (int v = 0; v < vertexCount; ++v)
+                offsets[v + 1] += offsets[v];
+
+            auto const residualCount = static_cast<size_t>(offsets.back());
+            g.heads.resize(residualCount);
+            g.mates.resize(residualCount);
+            g.residual.resize(residualCount);
+            g.forward.assign(arcs.size(), -1);
+
+            std::vector<int> position(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                auto const arc = arcs[i];
+                if (!isEdge(arc))
+                    continue;
+
+                auto const there = position[arc.source]++;
+                auto const back  = position[arc.target]++;
+                g.heads[there]    = arc.target;
+                g.heads[back]     = arc.source;
+                g.mates[there]    = back;
+                g.mates[back]     = there;
+                g.residual[there] = static_cast<Flow>(capacities[i]);
+                g.forward[i]      = there;
+            }
+
+            return g;
+        }
+
+
+        // Фаза 1 строит максимальный предпоток: активной выбирается вершина наибольшей высоты,
+        // высоты не меньше n означают "сток недостижим". Фаза 2 возвращает избытки в источник.
+        template <typename Flow>
+        class PushRelabel
+        {
+        public:
+            PushRelabel(ResidualGraph<Flow>& g, int source, int sink)
+                : _g(g)
+                , _n(g.getVertexCount())
+                , _source(source)
+                , _sink(sink)
+                , _height(static_cast<size_t>(_n))
+                , _current(static_cast<size_t>(_n))
+                , _excess(static_cast<size_t>(_n))
+                , _activeHead(static_cast<size_t>(_n), -1)
+                , _activeNext(static_cast<size_t>(_n), -1)
+                , _levelHead(static_cast<size_t>(_n), -1)
+                , _levelNext(static_cast<size_t>(_n), -1)
+                , _levelPrev(static_cast<size_t>(_n), -1)
+                , _tolerance(static_cast<size_t>(_n))
+            {
+                // Поток в double складывается в разном порядке, и в вершине может остаться избыток
+                // порядка ошибки округления, который некуда протолкнуть: такой остаток считается нулём.
+                if constexpr (std::is_floating_point_v<Flow>)
+                {
+                    constexpr Flow relativeTolerance = 1e-12;
+                    for (int v = 0; v < _n; ++v)
+                    {
+                        Flow incident {};
+                        for (int r = g.offsets[v]; r < g.offsets[v + 1]; ++r)
+                            incident += g.residual[r] + g.residual[g.mates[r]];
+                        _tolerance[v] = relativeTolerance * incident;
+                    }
+                }
+            }
+
+            void computeMaxPreflow()
+            {
+                auto& residual = _g.residual;
+                for (int r = _g.offsets[_source]; r < _g.offsets[_source + 1]; ++r)
+                {
+                    auto const delta = residual[r];
+                    residual[r] = 0;
+                    residual[_g.mates[r]] += delta;
+                    _excess[_g.heads[r]]  += delta;
+                }
+
+                // Пересчёт высот окупается, когда работа по переразметке сравнима с размером графа.
+                auto const relabelPeriod = int64_t{6} * _n + static_cast<int64_t>(_g.heads.size());
+                _globalRelabel();
+                while (_maxActive >= 0)
+                {
+                    auto const v = _activeHead[_maxActive];
+                    if (v == -1)
+                    {
+                        --_maxActive;
+                        continue;
+                    }
+
+                    _activeHead[_maxActive] = _activeNext[v];
+                    _discharge(v);
+                    if (_work > relabelPeriod)
+                        _globalRelabel();
+                }
+            }
+
+            /// Вершины, из которых сток достижим в остаточном графе (после фазы 1 -- сторона стока).
+            [[nodiscard]] auto markSinkSide() const
+                -> std::vector<int>
+            {
+                std::vector<int> reached(static_cast<size_t>(_n));
+                std::vector<int> queue { _sink };
+                reached[_sink] = 1;
+                for (size_t i = 0; i < queue.size(); ++i)
+                {
+                    auto const v = queue[i];
+                    for (int r = _g.offsets[v]; r < _g.offsets[v + 1]; ++r)
+                    {
+                        auto const u = _g.heads[r];
+                        if (!reached[u] && _g.residual[_g.mates[r]] > 0)
+                        {
+                            reached[u] = 1;
+                            queue.push_back(u);
+                        }
+                    }
+                }
+
+                return reached;
+            }
+
+            void returnExcess()
+            {
+                // Высоты -- расстояния до источника по остаточным дугам; избыток всегда
+                // может вернуться в источник, сток из вершин с избытком недостижим.
+                auto const unreached = 2 * _n;
+                std::ranges::fill(_height, unreached);
+                _height[_source] = 0;
+                std::vector<int> queue { _source };
+                for (size_t i = 0; i < queue.size(); ++i)
+                {
+                    auto const v = queue[i];
+                    for (int r = _g.offsets[v]; r < _g.offsets[v + 1]; ++r)
+                    {
+                        auto const u = _g.heads[r];
+                        if (_height[u] == unreached && u != _sink && _g.residual[_g.mates[r]] > 0)
+                        {
+                            _height[u] = _height[v] + 1;
+                            queue.push_back(u);
+                        }
+                    }
+                }
+
+                queue.clear();
+                for (int v = 0; v < _n; ++v)
+                {
+                    _current[v] = _g.offsets[v];
+                    if (v == _source || v == _sink)
+                        continue;
+                    if (_hasExcess(v))
+                        queue.push_back(v);
+                    else
+                        _excess[v] = 0;
+                }
+
+                auto& residual = _g.residual;
+                for (size_t i = 0; i < queue.size(); ++i)
+                {
+                    auto const v   = queue[i];
+                    auto const end = _g.offsets[v + 1];
+                    while (_hasExcess(v))
+                    {
+                        auto r = _current[v];
+                        for (; r < end && _hasExcess(v); ++r)
+                        {
+                            auto const w = _g.heads[r];
+                            if (w == _sink || residual[r] <= 0 || _height[w] != _height[v] - 1)
+                                continue;
+
+                            auto const delta = std::min(_excess[v], residual[r]);
+                            residual[r] -= delta;
+                            residual[_g.mates[r]] += delta;
+                            _excess[v] -= delta;
+                            if (w != _source && _excess[w] == 0)
+                                queue.push_back(w);
+                            _excess[w] += delta;
+                            if (residual[r] > 0)
+                                break;
+                        }
+
+                        if (!_hasExcess(v))
+                        {
+                            _current[v] = r;
+                            break;
+                        }
+
+                        auto minimum = unreached;
+                        for (int s = _g.offsets[v]; s < end; ++s)
+                            if (_g.heads[s] != _sink && residual[s] > 0)
+                                minimum = std::min(minimum, _height[_g.heads[s]]);
+                        if (minimum == unreached)
+                            break;
+                        _height[v]  = minimum + 1;
+                        _current[v] = _g.offsets[v];
+                    }
+
+                    // Вернуть некуда можно только остаток в пределах ошибки округления
+                    // (для целых -- ничего): больший остаток означает ошибку алгоритма.
+                    REQUIRE(!_hasExcess(v));
+                    _excess[v] = 0;
+                }
+            }
+
+            [[nodiscard]] auto getExcess(int v) const noexcept
+                -> Flow
+            {
+                return _excess[v];
+            }
+
+        private:
+            ResidualGraph<Flow>& _g;
+            int                  _n;
+            int                  _source;
+            int                  _sink;
+
+            std::vector<int>  _height;
+            std::vector<int>  _current;
+            std::vector<Flow> _excess;
+
+            // Активные вершины по высотам (односвязные списки) и все вершины высоты < n
+            // по высотам (двусвязные списки, для эвристики разрыва).
+            std::vector<int>  _activeHead;
+            std::vector<int>  _activeNext;
+            std::vector<int>  _levelHead;
+            std::vector<int>  _levelNext;
+            std::vector<int>  _levelPrev;
+            int               _maxActive {-1};
+            int               _maxHeight {};
+            int64_t           _work      {};
+            // Избыток не больше _tolerance[v] считается нулём (для целых -- ровно 0).
+            std::vector<Flow> _tolerance;
+
+            [[nodiscard]] bool _hasExcess(int v) const noexcept
+            {
+                return _excess[v] > _tolerance[v];
+            }
+
+            void _addActive(int v) noexcept
+            {
+                auto const h = _height[v];
+                _activeNext[v] = _activeHead[h];
+                _activeHead[h] = v;
+                _maxActive = std::max(_maxActive, h);
+            }
+
+            void _addToLevel(int v) noexcept
+            {
+                auto const h = _height[v];
+                _levelPrev[v] = -1;
+                _levelNext[v] = _levelHead[h];
+                if (_levelHead[h] != -1)
+                    _levelPrev[_levelHead[h]] = v;
+                _levelHead[h] = v;
+                _maxHeight = std::max(_maxHeight, h);
+            }
+
+            void _removeFromLevel(int v) noexcept
+            {
+                if (_levelPrev[v] != -1)
+                    _levelNext[_levelPrev[v]] = _levelNext[v];
+                else
+                    _levelHead[_height[v]] = _levelNext[v];
+                if (_levelNext[v] != -1)
+                    _levelPrev[_levelNext[v]] = _levelPrev[v];
+            }
+
+            // Точные расстояния до стока обратным обходом в ширину.
+            void _globalRelabel()
+            {
+                std::ranges::fill(_height, _n);
+                std::ranges::fill(_activeHead, -1);
+                std::ranges::fill(_levelHead, -1);
+                _maxActive = -1;
+                _maxHeight = 0;
+                _work      = 0;
+
+                _height[_sink] = 0;
+                std::vector<int> queue { _sink };
+                for (size_t i = 0; i < queue.size(); ++i)
+                {
+                    auto const v = queue[i];
+                    for (int r = _g.offsets[v]; r < _g.offsets[v + 1]; ++r)
+                    {
+                        auto const u = _g.heads[r];
+                        if (_height[u] == _n && u != _source && _g.residual[_g.mates[r]] > 0)
+                        {
+                            _height[u] = _height[v] + 1;
+                            queue.push_back(u);
+                        }
+                    }
+                }
+
+                for (size_t i = 1; i < queue.size(); ++i)
+                {
+                    auto const v = queue[i];
+                    _current[v] = _g.offsets[v];
+                    _addToLevel(v);
+                    if (_excess[v] > 0)
+                        _addActive(v);
+                }
+            }
+
+            // Ни одна вершина не имеет высоты h: вершины выше h отрезаны от стока.
+            void _gap(int h) noexcept
+            {
+                for (int k = h; k <= _maxHeight; ++k)
+                {
+                    for (int v = _levelHead[k]; v != -1; v = _levelNext[v])
+                        _height[v] = _n;
+                    _levelHead[k]  = -1;
+                    _activeHead[k] = -1;
+                }
+
+                _maxHeight = h - 1;
+                _maxActive = std::min(_maxActive, h - 1);
+            }
+
+            void _relabel(int v) noexcept
+            {
+                auto const begin = _g.offsets[v];
+                auto const end   = _g.offsets[v + 1];
+                _removeFromLevel(v);
+                _work += end - begin + 12;
+
+                auto height  = _n;
+                auto current = begin;
+                for (int r = begin; r < end; ++r)
+                {
+                    if (_g.residual[r] > 0 && _height[_g.heads[r]] + 1 < height)
+                    {
+                        height  = _height[_g.heads[r]] + 1;
+                        current = r;
+                    }
+                }
+
+                _height[v] = height;
+                if (height < _n)
+                {
+                    _current[v] = current;
+                    _addToLevel(v);
+                }
+            }
+
+            void _discharge(int v) noexcept
+            {
+                auto& residual = _g.residual;
+                auto const end = _g.offsets[v + 1];
+                while (true)
+                {
+                    auto const h = _height[v];
+                    auto r = _current[v];
+                    for (; r < end; ++r)
+                    {
+                        auto const w = _g.heads[r];
+                        if (residual[r] <= 0 || _height[w] != h - 1)
+                            continue;
+
+                        auto const delta = std::min(_excess[v], residual[r]);
+                        residual[r] -= delta;
+                        residual[_g.mates[r]] += delta;
+                        _excess[v] -= delta;
+                        if (w != _sink && _excess[w] == 0)
+                            _addActive(w);
+                        _excess[w] += delta;
+                        if (!_hasExcess(v))
+                            break;
+                    }
+
+                    if (!_hasExcess(v))
+                    {
+                        _excess[v]  = 0;
+                        _current[v] = r;
+                        return;
+                    }
+
+                    if (_levelHead[h] == v && _levelNext[v] == -1)
+                    {
+                        _removeFromLevel(v);
+                        _gap(h);
+                        _height[v] = _n;
+                        return;
+                    }
+
+                    _relabel(v);
+                    if (_height[v] >= _n)
+                        return;
+                }
+            }
+        };
+
+
+        template <typename Capacity>
+        [[nodiscard]] auto runMaxFlow(
+                EdgeListView const&       el,
+                int                       vertexCount,
+                std::span<Capacity const> capacities,
+                int                       source,
+                int                       sink
+            ) -> MaxFlow<Capacity>
+        {
+            using Flow = std::conditional_t<std::is_integral_v<Capacity>, int64_t, double>;
+
+            auto const arcs = el.getArcs();
+            if (static_cast<unsigned>(source) >= static_cast<unsigned>(vertexCount)
+             || static_cast<unsigned>(sink) >= static_cast<unsigned>(vertexCount)
+             || source == sink
+             || capacities.size() < arcs.size())
+                return {};
+
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                if constexpr (std::is_integral_v<Capacity>)
+                {
+                    if (capacities[i] < 0)
+                        return {};
+                }
+                else
+                {
+                    if (!(capacities[i] >= 0) || std::isinf(capacities[i]))
+                        return {};
+                }
+            }
+
+            auto g = makeResidualGraph<Flow>(arcs, vertexCount, capacities);
+            PushRelabel<Flow> pushRelabel(g, source, sink);
+            pushRelabel.computeMaxPreflow();
+
+            MaxFlow<Capacity> result;
+            result.value      = static_cast<double>(pushRelabel.getExcess(sink));
+            result.sourceSide = pushRelabel.markSinkSide();
+            for (int& side: result.sourceSide)
+                side = 1 - side;
+
+            pushRelabel.returnExcess();
+            result.arcFlows.resize(arcs.size());
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                auto const there = g.forward[i];
+                if (there == -1)
+                    continue;
+
+                auto const capacity = static_cast<Flow>(capacities[i]);
+                result.arcFlows[i] = static_cast<Capacity>(std::clamp(capacity - g.residual[there], Flow{}, capacity));
+            }
+
+            return result;
+        }
+
+    }
+
+
+    auto computeMaxFlow(
+            EdgeListView const&    el,
+            int                    vertexCount,
+            std::span<float const> capacities,
+            int                    source,
+            int                    sink
+        ) -> MaxFlow<float>
+    {
+        return runMaxFlow(el, vertexCount, capacities, source, sink);
+    }
+
+
+    auto computeMaxFlow(
+            EdgeListView const&    el,
+            int                    vertexCount,
+            std::span<int const>   capacities,
+            int                    source,
+            int                    sink
+        ) -> MaxFlow<int>
+    {
+        return runMaxFlow(el, vertexCount, capacities, source, sink);
+    }
+
+
+    auto computeMaxFlow(
+            Graph const& graph,
+            int          capacityAttribute,
+            int          source,
+            int          sink
+        ) -> MaxFlow<float>
+    {
+        auto const& el = graph.getEdgeListView();
+        if (static_cast<unsigned>(capacityAttribute) >= static_cast<unsigned>(el.getFloatAttributeCount()))
+            return {};
+        return computeMaxFlow(el, graph.getVertexCount(), el.getFloatAttributes(capacityAttribute), source, sink);
+    }
+
+}
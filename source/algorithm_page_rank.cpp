@@ -0,0 +1,309 @@
+/// @file  algorithm_page_rank.cpp
+/// @brief Степенной метод "вытягиванием" по транспонированному CSR: сбор значений
+///        по номерам источников (gather на AVX2), параллельно по блокам вершин.
+#include "../include/algorithm_page_rank.hpp"
+#include "../include/attribute_columns.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        // Вершин в блоке параллельного цикла.
+        constexpr int grain = 4096;
+
+
+#if defined(__AVX2__)
+        [[nodiscard]] inline auto horizontalSum(__m256 v) noexcept
+            -> float
+        {
+            auto const quad = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            auto const pair = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+            return _mm_cvtss_f32(_mm_add_ss(pair, _mm_movehdup_ps(pair)));
+        }
+#endif
+
+
+        // Сумма x[index[i]], i < count.
+        [[nodiscard]] auto sumGathered(int const* index, int count, float const* x) noexcept
+            -> float
+        {
+            int   i   = 0;
+            float sum = 0.f;
+#if defined(__AVX2__)
+            if (count >= 8)
+            {
+                auto acc = _mm256_setzero_ps();
+                for (; i + 8 <= count; i += 8)
+                {
+                    auto const at = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(index + i));
+                    acc = _mm256_add_ps(acc, _mm256_i32gather_ps(x, at, 4));
+                }
+
+                sum = horizontalSum(acc);
+            }
+#endif
+            for (; i < count; ++i)
+                sum += x[index[i]];
+            return sum;
+        }
+
+
+        // Сумма w[i] * x[index[i]], i < count.
+        [[nodiscard]] auto dotGathered(float const* w, int const* index, int count, float const* x) noexcept
+            -> float
+        {
+            int   i   = 0;
+            float sum = 0.f;
+#if defined(__AVX2__)
+            if (count >= 8)
+            {
+                auto acc = _mm256_setzero_ps();
+                for (; i + 8 <= count; i += 8)
+                {
+                    auto const at = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(index + i));
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(w + i), _mm256_i32gather_ps(x, at, 4)));
+                }
+
+                sum = horizontalSum(acc);
+            }
+#endif
+            for (; i < count; ++i)
+                sum += w[i] * x[index[i]];
+            return sum;
+        }
+
+
+        [[nodiscard]] bool isValid(PowerIterationOptions const& options) noexcept
+        {
+            return options.damping >= 0.f && options.damping <= 1.f
+                && options.tolerance >= 0.f
+                && options.maxIterations >= 0;
+        }
+
+
+        // teleport пуст -- равномерное распределение.
+        [[nodiscard]] auto runPageRank(
+                AdjacencyListView const&     al,
+                std::vector<float> const&    teleport,
+                PowerIterationOptions const& options
+            ) -> PowerIteration
+        {
+            auto const forward     = CompressedAdjacency::fromAdjacencyList(al);
+            auto const pull        = forward.transposed();
+            auto const vertexCount = pull.getVertexCount();
+            if (vertexCount == 0)
+                return {};
+
+            auto const offsets = pull.getOffsets().data();
+            auto const sources = pull.getAllTargets().data();
+            auto const damping = options.damping;
+            auto const uniform = 1.f / static_cast<float>(vertexCount);
+
+            std::vector<float> outWeight(static_cast<size_t>(vertexCount));
+            for (int u = 0; u < vertexCount; ++u)
+                if (auto const d = forward.getTargetCount(u); d != 0)
+                    outWeight[u] = 1.f / static_cast<float>(d);
+
+            // rank -- текущие значения, share[u] = rank[u] / (число исходящих дуг u).
+            PowerIteration result;
+            auto& rank = result.values;
+            rank.assign(static_cast<size_t>(vertexCount), uniform);
+            std::vector<float> next(rank.size()), share(rank.size()), nextShare(rank.size());
+
+            double dangling = 0.;
+            for (int u = 0; u < vertexCount; ++u)
+            {
+                share[u] = rank[u] * outWeight[u];
+                if (outWeight[u] == 0.f)
+                    dangling += rank[u];
+            }
+
+            auto const workerCount = static_cast<size_t>(getWorkerCount());
+            std::vector<double> partialResidual(workerCount), partialDangling(workerCount);
+            result.eigenvalue = 1.f;
+            while (result.iterations < options.maxIterations)
+            {
+                // Телепортация и вес висячих вершин распределяются по teleport.
+                auto const base = static_cast<float>((1. - damping) + damping * dangling);
+                std::ranges::fill(partialResidual, 0.);
+                std::ranges::fill(partialDangling, 0.);
+                parallelForBlocks(vertexCount, grain,
+                    [&](int worker, int begin, int end)
+                    {
+                        double residual = 0., nextDangling = 0.;
+                        for (int v = begin; v < end; ++v)
+                        {
+                            auto const inflow = sumGathered(sources + offsets[v], offsets[v + 1] - offsets[v], share.data());
+                            auto const r      = damping * inflow + base * (teleport.empty()? uniform: teleport[v]);
+                            residual += std::abs(r - rank[v]);
+                            next[v]      = r;
+                            nextShare[v] = r * outWeight[v];
+                            if (outWeight[v] == 0.f)
+                                nextDangling += r;
+                        }
+
+                        partialResidual[worker] += residual;
+                        partialDangling[worker] += nextDangling;
+                    });
+
+                rank.swap(next);
+                share.swap(nextShare);
+                dangling        = std::reduce(partialDangling.begin(), partialDangling.end());
+                result.residual = static_cast<float>(std::reduce(partialResidual.begin(), partialResidual.end()));
+                ++result.iterations;
+                if (result.residual <= options.tolerance)
+                {
+                    result.converged = true;
+                    break;
+                }
+            }
+
+            return result;
+        }
+
+    }
+
+
+    bool multiplyPull(
+            CompressedAdjacency const& pull,
+            std::span<float const>     arcValues,
+            std::span<float const>     x,
+            std::span<float>           y
+        )
+    {
+        auto const vertexCount = static_cast<size_t>(pull.getVertexCount());
+        if (arcValues.size() != static_cast<size_t>(pull.getArcCount())
+         || x.size() != vertexCount || y.size() != vertexCount)
+            return false;
+
+        auto const offsets = pull.getOffsets().data();
+        auto const columns = pull.getAllTargets().data();
+        parallelForBlocks(static_cast<int>(vertexCount), grain,
+            [&](int, int begin, int end)
+            {
+                for (int v = begin; v < end; ++v)
+                    y[v] = dotGathered(arcValues.data() + offsets[v], columns + offsets[v], offsets[v + 1] - offsets[v], x.data());
+            });
+
+        return true;
+    }
+
+
+    auto computeDominantEigenvector(
+            CompressedAdjacency const&   pull,
+            std::span<float const>       arcValues,
+            PowerIterationOptions const& options
+        ) -> PowerIteration
+    {
+        auto const vertexCount = pull.getVertexCount();
+        if (vertexCount == 0 || !isValid(options)
+         || arcValues.size() != static_cast<size_t>(pull.getArcCount()))
+            return {};
+
+        PowerIteration result;
+        auto& x = result.values;
+        x.assign(static_cast<size_t>(vertexCount), 1.f / static_cast<float>(vertexCount));
+        std::vector<float> y(x.size());
+        while (result.iterations < options.maxIterations)
+        {
+            multiplyPull(pull, arcValues, x, y);
+            ++result.iterations;
+
+            double norm = 0.;
+            for (float const value: y)
+                norm += std::abs(value);
+            // A x = 0: вектор не продолжить, собственное число 0.
+            if (norm == 0.)
+            {
+                result.eigenvalue = 0.f;
+                break;
+            }
+
+            // Сумма x равна 1, поэтому |A x| -- оценка собственного числа.
+            result.eigenvalue = static_cast<float>(norm);
+            auto const scale  = static_cast<float>(1. / norm);
+            double residual = 0.;
+            for (size_t v = 0; v < y.size(); ++v)
+            {
+                y[v] *= scale;
+                residual += std::abs(y[v] - x[v]);
+            }
+
+            x.swap(y);
+            result.residual = static_cast<float>(residual);
+            if (result.residual <= options.tolerance)
+            {
+                result.converged = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+
+    auto computePageRank(
+            AdjacencyListView const&     al,
+            PowerIterationOptions const& options
+        ) -> PowerIteration
+    {
+        if (!isValid(options))
+            return {};
+        return runPageRank(al, {}, options);
+    }
+
+
+    auto computePersonalizedPageRank(
+            AdjacencyListView const&     al,
+            std::span<float const>       personalization,
+            PowerIterationOptions const& options
+        ) -> PowerIteration
+    {
+        if (!isValid(options) || personalization.size() != static_cast<size_t>(al.getVertexCount()))
+            return {};
+
+        double total = 0.;
+        for (float const weight: personalization)
+        {
+            if (!(weight >= 0.f) || std::isinf(weight))
+                return {};
+            total += weight;
+        }
+
+        if (total <= 0.)
+            return {};
+
+        std::vector<float> teleport(personalization.size());
+        for (size_t v = 0; v < teleport.size(); ++v)
+            teleport[v] = static_cast<float>(personalization[v] / total);
+        return runPageRank(al, teleport, options);
+    }
+
+
+    auto computePageRank(
+            EditableAdjacencyList&       al,
+            int                          rankAttribute,
+            PowerIterationOptions const& options
+        ) -> PowerIteration
+    {
+        if (static_cast<unsigned>(rankAttribute) >= static_cast<unsigned>(al.getVertexFloatAttributeCount()))
+            return {};
+
+        auto result = computePageRank(static_cast<AdjacencyListView const&>(al), options);
+        storeVertexFloatAttributes(al, rankAttribute, result.values);
+        return result;
+    }
+
+}
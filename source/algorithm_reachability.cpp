@@ -0,0 +1,235 @@
+/// @file  algorithm_reachability.cpp
+/// @brief Компоненты сильной связности (Тарьян) и транзитивное замыкание на битовых строках.
+#include "../include/algorithm_reachability.hpp"
+#include "../include/aligned_bit_matrix.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <cstdint>
+#include <thread>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        [[nodiscard]] auto toDenseAdjacencyMatrix(AlignedBitMatrix const& bits, int vertexCount)
+            -> std::unique_ptr<EditableDenseAdjacencyMatrix>
+        {
+            auto result = newDenseAdjacencyMatrix(vertexCount);
+            for (int i = 0; i < vertexCount; ++i)
+            {
+                auto row = result->getRow(i);
+                bits.forEachSetBit(i, [&row](int j) { row.setBit(j); });
+            }
+
+            return result;
+        }
+
+    }
+
+
+    auto computeStronglyConnectedComponents(AdjacencyListView const& al)
+        -> StronglyConnectedComponents
+    {
+        auto const csr         = CompressedAdjacency::fromAdjacencyList(al);
+        auto const vertexCount = csr.getVertexCount();
+        auto const offsets     = csr.getOffsets();
+        auto const targets     = csr.getAllTargets();
+
+        StronglyConnectedComponents result;
+        auto& component = result.components;
+        component.assign(static_cast<size_t>(vertexCount), -1);
+
+        std::vector<int>  index(static_cast<size_t>(vertexCount), -1);
+        std::vector<int>  low(static_cast<size_t>(vertexCount));
+        std::vector<char> onStack(static_cast<size_t>(vertexCount));
+        std::vector<int>  stack;
+        // Кадр "рекурсии": вершина и позиция следующей дуги в CSR.
+        std::vector<std::pair<int, int>> calls;
+        int counter = 0;
+
+        auto const open = [&](int v)
+            {
+                index[v] = low[v] = counter++;
+                stack.push_back(v);
+                onStack[v] = 1;
+                calls.emplace_back(v, offsets[v]);
+            };
+
+        for (int root = 0; root < vertexCount; ++root)
+        {
+            if (index[root] != -1)
+                continue;
+
+            open(root);
+            while (!calls.empty())
+            {
+                auto const v   = calls.back().first;
+                auto&      pos = calls.back().second;
+                if (pos < offsets[v + 1])
+                {
+                    auto const t = targets[pos++];
+                    if (index[t] == -1)
+                        open(t);
+                    else if (onStack[t])
+                        low[v] = std::min(low[v], index[t]);
+                    continue;
+                }
+
+                if (low[v] == index[v])
+                {
+                    int w;
+                    do
+                    {
+                        w = stack.back();
+                        stack.pop_back();
+                        onStack[w]   = 0;
+                        component[w] = result.componentCount;
+                    } while (w != v);
+
+                    ++result.componentCount;
+                }
+
+                calls.pop_back();
+                if (!calls.empty())
+                {
+                    auto const parent = calls.back().first;
+                    low[parent] = std::min(low[parent], low[v]);
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    auto computeTransitiveClosure(DenseAdjacencyMatrixView const& am)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>
+    {
+        auto const vertexCount = am.getVertexCount();
+        auto bits = AlignedBitMatrix::fromAdjacencyMatrix(am);
+
+        // Потоки владеют непересекающимися полосами строк и синхронизируются
+        // барьером после каждого k: строка k на шаге k не изменяется.
+        auto const workerCount = std::clamp(vertexCount / 64, 1, getWorkerCount());
+        std::barrier sync(workerCount);
+        auto const work = [&](int worker)
+            {
+                auto const begin = static_cast<int>(int64_t(vertexCount) * worker / workerCount);
+                auto const end   = static_cast<int>(int64_t(vertexCount) * (worker + 1) / workerCount);
+                for (int k = 0; k < vertexCount; ++k)
+                {
+                    auto const rowK = bits.row(k);
+                    for (int i = begin; i < end; ++i)
+                        if (i != k && bits.get(i, k))
+                            bits.orRow(i, rowK);
+
+                    sync.arrive_and_wait();
+                }
+            };
+
+        {
+            std::vector<std::jthread> threads;
+            for (int worker = 1; worker < workerCount; ++worker)
+                threads.emplace_back(work, worker);
+            work(0);
+        }
+
+        return toDenseAdjacencyMatrix(bits, vertexCount);
+    }
+
+
+    auto computeTransitiveClosure(AdjacencyListView const& al)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>
+    {
+        auto const vertexCount = al.getVertexCount();
+        auto const scc         = computeStronglyConnectedComponents(al);
+        auto const count       = scc.componentCount;
+        auto const& component  = scc.components;
+
+        // Вершины, сгруппированные по компонентам.
+        std::vector<int> memberOffsets(static_cast<size_t>(count) + 1);
+        for (int const c: component)
+            ++memberOffsets[c + 1];
+        for (int c = 0; c < count; ++c)
+            memberOffsets[c + 1] += memberOffsets[c];
+
+        std::vector<int> members(static_cast<size_t>(vertexCount));
+        {
+            std::vector<int> position(memberOffsets.begin(), memberOffsets.end() - 1);
+            for (int v = 0; v < vertexCount; ++v)
+                members[position[component[v]]++] = v;
+        }
+
+        // Достижимость между компонентами; компоненты-преемники имеют меньшие номера
+        // и к моменту обработки c уже обработаны.
+        AlignedBitMatrix reach(count, count);
+        std::vector<int> seenBy(static_cast<size_t>(count), -1);
+        for (int c = 0; c < count; ++c)
+        {
+            auto const first = memberOffsets[c];
+            auto const last  = memberOffsets[c + 1];
+            if (last - first > 1)
+                reach.set(c, c);
+
+            for (int m = first; m < last; ++m)
+            {
+                for (int const t: al.getTargets(members[m]))
+                {
+                    auto const d = component[t];
+                    if (d == c)
+                    {
+                        reach.set(c, c);
+                        continue;
+                    }
+
+                    if (seenBy[d] == c)
+                        continue;
+
+                    seenBy[d] = c;
+                    reach.set(c, d);
+                    reach.orRow(c, reach.row(d));
+                }
+            }
+        }
+
+        // Строка вершины -- объединение членов достижимых компонент.
+        AlignedBitMatrix bits(count, vertexCount);
+        parallelForBlocks(count, 16,
+            [&](int, int begin, int end)
+            {
+                for (int c = begin; c < end; ++c)
+                {
+                    reach.forEachSetBit(c, [&](int d)
+                        {
+                            for (int m = memberOffsets[d]; m < memberOffsets[d + 1]; ++m)
+                                bits.set(c, members[m]);
+                        });
+                }
+            });
+
+        auto result = newDenseAdjacencyMatrix(vertexCount);
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            auto row = result->getRow(v);
+            bits.forEachSetBit(component[v], [&row](int j) { row.setBit(j); });
+        }
+
+        return result;
+    }
+
+
+    auto computeTransitiveClosure(Graph const& graph)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>
+    {
+        auto const vertexCount = int64_t{ graph.getVertexCount() };
+        if (graph.getArcCount() * int64_t{64} >= vertexCount * vertexCount)
+            return computeTransitiveClosure(graph.getAdjacencyMatrixView());
+        return computeTransitiveClosure(graph.getAdjacencyListView());
+    }
+
+}
@@ -0,0 +1,460 @@
+/// @file  algorithm_shortest_paths.cpp
+/// @brief Реализация алгоритма Дейкстры и delta-stepping поверх CompressedAdjacency.
+#include "../include/algorithm_shortest_paths.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+
+
+        // Веса дуг в порядке CSR. Пусто, если столбца нет или есть отрицательный (NaN) вес.
+        [[nodiscard]] auto gatherWeights(
+                CompressedAdjacency const& csr,
+                EdgeListView const&        el,
+                int                        weightAttribute
+            ) -> std::optional<std::vector<float>>
+        {
+            if (weightAttribute < 0)
+                return std::vector<float>(static_cast<size_t>(csr.getArcCount()), 1.f);
+
+            if (weightAttribute >= el.getFloatAttributeCount())
+                return std::nullopt;
+
+            auto weights = csr.gather(el.getFloatAttributes(weightAttribute));
+            if (weights.size() != static_cast<size_t>(csr.getArcCount()))
+                return std::nullopt;
+
+            for (float const w: weights)
+                if (!(w >= 0.f))
+                    return std::nullopt;
+
+            return weights;
+        }
+
+
+        [[nodiscard]] auto makeUnreached(int vertexCount)
+            -> ShortestPaths
+        {
+            auto const n = static_cast<size_t>(vertexCount);
+            return
+            {
+                .distances  = std::vector<float>(n, infinity),
+                .parents    = std::vector<int>(n, -1),
+                .parentArcs = std::vector<int>(n, -1)
+            };
+        }
+
+
+        // 4-арная куча с минимумом в корне, хранящая ключи рядом с вершинами:
+        // все четыре потомка занимают 32 байта (половину строки кэша).
+        class IndexedQuaternaryHeap
+        {
+        public:
+            explicit IndexedQuaternaryHeap(int vertexCount)
+                : _position(static_cast<size_t>(vertexCount), -1)
+            {
+                // Пусто.
+            }
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return _heap.empty();
+            }
+
+            /// Добавить вершину или уменьшить её ключ.
+            void pushOrDecrease(int vertex, float key)
+            {
+                auto index = _position[vertex];
+                if (index < 0)
+                {
+                    index = static_cast<int>(_heap.size());
+                    _heap.push_back({ key, vertex });
+                }
+                else
+                {
+                    _heap[index].key = key;
+                }
+
+                _siftUp(index);
+            }
+
+            auto popMin() noexcept
+                -> std::pair<float, int>
+            {
+                auto const top = _heap.front();
+                _position[top.vertex] = -1;
+
+                auto const last = _heap.back();
+                _heap.pop_back();
+                if (!_heap.empty())
+                {
+                    _heap.front() = last;
+                    _siftDown(0);
+                }
+
+                return { top.key, top.vertex };
+            }
+
+        private:
+            struct Item
+            {
+                float key;
+                int   vertex;
+            };
+
+            static constexpr int arity = 4;
+
+            std::vector<Item> _heap;
+            std::vector<int>  _position;
+
+            void _place(int index, Item item) noexcept
+            {
+                _heap[index] = item;
+                _position[item.vertex] = index;
+            }
+
+            void _siftUp(int index) noexcept
+            {
+                auto const item = _heap[index];
+                while (index > 0)
+                {
+                    auto const parent = (index - 1) / arity;
+                    if (_heap[parent].key <= item.key)
+                        break;
+                    _place(index, _heap[parent]);
+                    index = parent;
+                }
+
+                _place(index, item);
+            }
+
+            void _siftDown(int index) noexcept
+            {
+                auto const item = _heap[index];
+                auto const size = static_cast<int>(_heap.size());
+                for (;;)
+                {
+                    auto const first = index * arity + 1;
+                    if (first >= size)
+                        break;
+
+                    auto best = first;
+                    auto const last = std::min(first + arity, size);
+                    for (int child = first + 1; child < last; ++child)
+                        if (_heap[child].key < _heap[best].key)
+                            best = child;
+
+                    if (item.key <= _heap[best].key)
+                        break;
+                    _place(index, _heap[best]);
+                    index = best;
+                }
+
+                _place(index, item);
+            }
+        };
+
+
+        // Расстояние и позиция дуги-родителя (в CSR) упакованы в одно 64-битное слово,
+        // чтобы атомарно обновлять их вместе. Для неотрицательных float порядок
+        // битовых представлений совпадает с порядком чисел.
+        [[nodiscard]] constexpr auto pack(float distance, int arcPosition) noexcept
+            -> uint64_t
+        {
+            return (uint64_t{ std::bit_cast<uint32_t>(distance) } << 32)
+                 | static_cast<uint32_t>(arcPosition);
+        }
+
+        [[nodiscard]] constexpr auto unpackDistance(uint64_t packed) noexcept
+            -> float
+        {
+            return std::bit_cast<float>(static_cast<uint32_t>(packed >> 32));
+        }
+
+        [[nodiscard]] constexpr auto unpackArcPosition(uint64_t packed) noexcept
+            -> int
+        {
+            return static_cast<int>(static_cast<uint32_t>(packed));
+        }
+
+        // Атомарный минимум; true, если расстояние уменьшилось.
+        bool relaxAtomic(std::atomic<uint64_t>& slot, float distance, int arcPosition) noexcept
+        {
+            auto const desired = pack(distance, arcPosition);
+            auto current = slot.load(std::memory_order_relaxed);
+            while ((current >> 32) > (desired >> 32))
+            {
+                if (slot.compare_exchange_weak(current, desired, std::memory_order_relaxed))
+                    return true;
+            }
+
+            return false;
+        }
+
+    }
+
+
+    auto Dijkstra::run(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute,
+            int                 source
+        ) -> ShortestPaths
+    {
+        if (static_cast<unsigned>(source) >= static_cast<unsigned>(vertexCount))
+            return {};
+
+        auto const csr     = CompressedAdjacency::fromEdgeList(el, vertexCount);
+        auto const weights = gatherWeights(csr, el, weightAttribute);
+        if (!weights)
+            return {};
+
+        auto result  = makeUnreached(vertexCount);
+        auto& dist   = result.distances;
+        auto const notify  = hasSubscribers();
+        auto const offsets = csr.getOffsets();
+        auto const targets = csr.getAllTargets();
+        auto const arcs    = csr.getAllArcIndices();
+
+        IndexedQuaternaryHeap heap(vertexCount);
+        dist[source] = 0.f;
+        heap.pushOrDecrease(source, 0.f);
+        if (notify)
+            broadcast(events::VertexIsOpened{ source });
+
+        while (!heap.empty())
+        {
+            auto const [distance, vertex] = heap.popMin();
+            if (notify)
+                broadcast(events::VertexIsClosed{ vertex });
+
+            for (int i = offsets[vertex]; i < offsets[vertex + 1]; ++i)
+            {
+                auto const target    = targets[i];
+                auto const candidate = distance + (*weights)[i];
+                if (!(candidate < dist[target]))
+                    continue;
+
+                auto const opened = dist[target] == infinity;
+                dist[target]              = candidate;
+                result.parents[target]    = vertex;
+                result.parentArcs[target] = arcs[i];
+                heap.pushOrDecrease(target, candidate);
+
+                if (notify)
+                {
+                    if (opened)
+                        broadcast(events::VertexIsOpened{ target });
+                    broadcast(events::ArcIsTree{ .arc = { vertex, target } });
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    auto Dijkstra::run(Graph const& graph, int weightAttribute, int source)
+        -> ShortestPaths
+    {
+        return run(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute, source);
+    }
+
+
+    auto DeltaStepping::run(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute,
+            int                 source
+        ) -> ShortestPaths
+    {
+        if (static_cast<unsigned>(source) >= static_cast<unsigned>(vertexCount)
+         || !(_delta >= 0.f) || std::isinf(_delta))
+            return {};
+
+        auto const csr     = CompressedAdjacency::fromEdgeList(el, vertexCount);
+        auto const weights = gatherWeights(csr, el, weightAttribute);
+        if (!weights)
+            return {};
+
+        auto const offsets = csr.getOffsets();
+        auto const targets = csr.getAllTargets();
+        auto const& w      = *weights;
+
+        auto delta = _delta;
+        if (delta == 0.f)
+        {
+            double sum = 0.;
+            for (float const weight: w)
+                sum += weight;
+            delta = w.empty() || sum == 0.? 1.f: static_cast<float>(sum / w.size());
+            // Среди весов может быть бесконечность.
+            if (std::isinf(delta))
+                delta = std::numeric_limits<float>::max();
+        }
+
+        // Частное больших расстояний и малого delta не помещается в uint64_t:
+        // все такие вершины попадают в последнюю корзину.
+        constexpr auto lastBucket = uint64_t{1} << 62;
+        auto const bucketOf = [delta](float distance) noexcept
+            {
+                auto const quotient = distance / delta;
+                return quotient < static_cast<float>(lastBucket)?
+                    static_cast<uint64_t>(quotient): lastBucket;
+            };
+
+        std::vector<std::atomic<uint64_t>> state(static_cast<size_t>(vertexCount));
+        for (auto& slot: state)
+            slot.store(pack(infinity, -1), std::memory_order_relaxed);
+        state[source].store(pack(0.f, -1), std::memory_order_relaxed);
+
+        auto const distanceOf = [&state](int vertex) noexcept
+            {
+                return unpackDistance(state[vertex].load(std::memory_order_relaxed));
+            };
+
+        // Отметки, чтобы не обрабатывать вершину дважды за фазу (и за корзину).
+        std::vector<uint64_t> phaseStamp(static_cast<size_t>(vertexCount), 0);
+        std::vector<uint64_t> bucketStamp(static_cast<size_t>(vertexCount), 0);
+        uint64_t phase = 0;
+
+        std::vector<std::vector<int>> improved(static_cast<size_t>(getWorkerCount()));
+        std::map<uint64_t, std::vector<int>> buckets;
+        buckets[0].push_back(source);
+
+        // Релаксировать лёгкие (light == true) или тяжёлые дуги вершин из vertices.
+        auto const relax = [&](std::vector<int> const& vertices, bool light)
+            {
+                parallelForBlocks(static_cast<int>(vertices.size()), 256,
+                    [&](int worker, int begin, int end)
+                    {
+                        auto& out = improved[worker];
+                        for (int k = begin; k < end; ++k)
+                        {
+                            auto const vertex   = vertices[k];
+                            auto const distance = distanceOf(vertex);
+                            for (int i = offsets[vertex]; i < offsets[vertex + 1]; ++i)
+                            {
+                                if ((w[i] <= delta) != light)
+                                    continue;
+                                if (relaxAtomic(state[targets[i]], distance + w[i], i))
+                                    out.push_back(targets[i]);
+                            }
+                        }
+                    });
+            };
+
+        auto result = makeUnreached(vertexCount);
+        auto const notify = hasSubscribers();
+
+        std::vector<int> frontier, settled;
+        while (!buckets.empty())
+        {
+            auto const node  = buckets.begin();
+            auto const index = node->first;
+            auto pending     = std::move(node->second);
+            buckets.erase(node);
+            settled.clear();
+
+            while (!pending.empty())
+            {
+                ++phase;
+                frontier.clear();
+                for (int const vertex: pending)
+                {
+                    if (phaseStamp[vertex] == phase || bucketOf(distanceOf(vertex)) != index)
+                        continue;
+
+                    phaseStamp[vertex] = phase;
+                    frontier.push_back(vertex);
+                    if (bucketStamp[vertex] != index + 1)
+                    {
+                        bucketStamp[vertex] = index + 1;
+                        settled.push_back(vertex);
+                    }
+                }
+
+                relax(frontier, true);
+
+                pending.clear();
+                for (auto& out: improved)
+                {
+                    for (int const vertex: out)
+                    {
+                        auto const bucket = bucketOf(distanceOf(vertex));
+                        if (bucket == index)
+                            pending.push_back(vertex);
+                        else
+                            buckets[bucket].push_back(vertex);
+                    }
+
+                    out.clear();
+                }
+            }
+
+            relax(settled, false);
+            for (auto& out: improved)
+            {
+                for (int const vertex: out)
+                    buckets[bucketOf(distanceOf(vertex))].push_back(vertex);
+                out.clear();
+            }
+
+            if (notify)
+            {
+                for (int const vertex: settled)
+                {
+                    auto const arcPosition = unpackArcPosition(state[vertex].load());
+                    if (arcPosition >= 0)
+                    {
+                        auto const parent = static_cast<int>(
+                            std::ranges::upper_bound(offsets, arcPosition) - offsets.begin()) - 1;
+                        broadcast(events::ArcIsTree{ .arc = { parent, vertex } });
+                    }
+
+                    broadcast(events::VertexIsClosed{ vertex });
+                }
+            }
+        }
+
+        auto const arcs = csr.getAllArcIndices();
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            auto const packed = state[v].load(std::memory_order_relaxed);
+            result.distances[v] = unpackDistance(packed);
+
+            auto const arcPosition = unpackArcPosition(packed);
+            if (arcPosition < 0)
+                continue;
+
+            result.parents[v] = static_cast<int>(
+                std::ranges::upper_bound(offsets, arcPosition) - offsets.begin()) - 1;
+            result.parentArcs[v] = arcs[arcPosition];
+        }
+
+        return result;
+    }
+
+
+    auto DeltaStepping::run(Graph const& graph, int weightAttribute, int source)
+        -> ShortestPaths
+    {
+        return run(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute, source);
+    }
+
+}
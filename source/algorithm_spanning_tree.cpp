@@ -0,0 +1,327 @@
+/// @file  algorithm_spanning_tree.cpp
+/// @brief Алгоритмы Краскала (параллельная сортировка номеров дуг) и Борувки
+///        (параллельный выбор лёгких рёбер компонент).
+#include "../include/algorithm_spanning_tree.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        // Рёбер в блоке параллельного цикла.
+        constexpr int grain = 4096;
+
+
+        // Веса всех дуг списка (по номерам). Пусто, если столбца нет или у учитываемой дуги вес NaN.
+        [[nodiscard]] auto loadWeights(
+                EdgeListView const&     el,
+                std::vector<int> const& edges,
+                int                     weightAttribute
+            ) -> std::optional<std::vector<float>>
+        {
+            auto const arcCount = el.getArcs().size();
+            if (weightAttribute < 0)
+                return std::vector<float>(arcCount, 1.f);
+
+            if (weightAttribute >= el.getFloatAttributeCount())
+                return std::nullopt;
+
+            auto const column = el.getFloatAttributes(weightAttribute);
+            if (column.size() < arcCount)
+                return std::nullopt;
+
+            std::vector<float> weights(column.begin(), column.begin() + arcCount);
+            for (int const arc: edges)
+            {
+                if (weights[arc] != weights[arc])
+                    return std::nullopt;
+                // -0 и +0 должны давать одинаковые ключи Борувки.
+                if (weights[arc] == 0.f)
+                    weights[arc] = 0.f;
+            }
+
+            return weights;
+        }
+
+
+        // Номера дуг, являющихся рёбрами: обе вершины в [0, vertexCount), не петля.
+        [[nodiscard]] auto collectEdges(EdgeListView const& el, int vertexCount)
+            -> std::vector<int>
+        {
+            auto const arcs = el.getArcs();
+            std::vector<int> edges;
+            edges.reserve(arcs.size());
+            for (size_t i = 0; i < arcs.size(); ++i)
+            {
+                auto const [source, target] = arcs[i];
+                if (static_cast<unsigned>(source) < static_cast<unsigned>(vertexCount)
+                 && static_cast<unsigned>(target) < static_cast<unsigned>(vertexCount)
+                 && source != target)
+                    edges.push_back(static_cast<int>(i));
+            }
+
+            return edges;
+        }
+
+
+        // Система непересекающихся множеств: объединение по размеру, сжатие путей делением пополам.
+        class DisjointSets
+        {
+        public:
+            explicit DisjointSets(int count)
+                : _parent(static_cast<size_t>(count))
+                , _size(static_cast<size_t>(count), 1)
+            {
+                std::iota(_parent.begin(), _parent.end(), 0);
+            }
+
+            [[nodiscard]] auto find(int x) noexcept
+                -> int
+            {
+                while (_parent[x] != x)
+                {
+                    _parent[x] = _parent[_parent[x]];
+                    x = _parent[x];
+                }
+
+                return x;
+            }
+
+            /// Без сжатия путей: можно вызывать из нескольких потоков одновременно.
+            [[nodiscard]] auto findRoot(int x) const noexcept
+                -> int
+            {
+                while (_parent[x] != x)
+                    x = _parent[x];
+                return x;
+            }
+
+            /// @return false, если a и b уже в одном множестве
+            bool unite(int a, int b) noexcept
+            {
+                a = find(a);
+                b = find(b);
+                if (a == b)
+                    return false;
+
+                if (_size[a] < _size[b])
+                    std::swap(a, b);
+                _parent[b] = a;
+                _size[a] += _size[b];
+                return true;
+            }
+
+        private:
+            std::vector<int> _parent;
+            std::vector<int> _size;
+        };
+
+
+        // Ключ ребра для атомарного минимума: порядок ключей совпадает с порядком (вес, номер дуги).
+        [[nodiscard]] inline auto makeKey(float weight, int arc) noexcept
+            -> uint64_t
+        {
+            auto bits = std::bit_cast<uint32_t>(weight);
+            bits = (bits & 0x8000'0000u) != 0? ~bits: bits | 0x8000'0000u;
+            return uint64_t{bits} << 32 | static_cast<uint32_t>(arc);
+        }
+
+        constexpr auto noKey = UINT64_MAX;
+
+
+        inline void lowerTo(uint64_t& slot, uint64_t key) noexcept
+        {
+            std::atomic_ref ref(slot);
+            auto current = ref.load(std::memory_order_relaxed);
+            while (key < current && !ref.compare_exchange_weak(current, key, std::memory_order_relaxed))
+            {
+                // Пусто.
+            }
+        }
+
+
+        // Элементы items, для которых keep истинно, в исходном порядке.
+        template <typename Keep>
+        [[nodiscard]] auto parallelFilter(std::vector<int> const& items, Keep keep)
+            -> std::vector<int>
+        {
+            auto const count = static_cast<int>(items.size());
+            if (count == 0)
+                return {};
+
+            // Блоки parallelForBlocks начинаются с кратных grain: номер блока -- begin / grain.
+            std::vector<int> blockStart(static_cast<size_t>((count - 1) / grain + 2));
+            parallelForBlocks(count, grain,
+                [&](int, int begin, int end)
+                {
+                    blockStart[begin / grain + 1] = static_cast<int>(
+                        std::count_if(items.begin() + begin, items.begin() + end, keep));
+                });
+
+            std::partial_sum(blockStart.begin(), blockStart.end(), blockStart.begin());
+            std::vector<int> result(static_cast<size_t>(blockStart.back()));
+            parallelForBlocks(count, grain,
+                [&](int, int begin, int end)
+                {
+                    std::copy_if(items.begin() + begin, items.begin() + end,
+                        result.begin() + blockStart[begin / grain], keep);
+                });
+
+            return result;
+        }
+
+    }
+
+
+    auto Kruskal::run(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute
+        ) -> SpanningForest
+    {
+        if (vertexCount < 0)
+            return {};
+
+        auto edges         = collectEdges(el, vertexCount);
+        auto const weights = loadWeights(el, edges, weightAttribute);
+        if (!weights)
+            return {};
+
+        auto const& w = *weights;
+        if (weightAttribute >= 0)
+        {
+            parallelSort(edges.begin(), edges.end(),
+                [&w](int a, int b) noexcept
+                {
+                    return w[a] < w[b] || (w[a] == w[b] && a < b);
+                });
+        }
+
+        auto const arcs   = el.getArcs();
+        auto const notify = hasSubscribers();
+
+        SpanningForest result;
+        result.treeCount = vertexCount;
+        DisjointSets sets(vertexCount);
+        for (int const arc: edges)
+        {
+            if (result.treeCount <= 1)
+                break;
+
+            auto const [source, target] = arcs[arc];
+            if (!sets.unite(source, target))
+                continue;
+
+            result.arcs.push_back(arc);
+            result.totalWeight += w[arc];
+            --result.treeCount;
+            if (notify)
+                broadcast(events::ArcIsTree{ .arc = { source, target } });
+        }
+
+        return result;
+    }
+
+
+    auto Kruskal::run(Graph const& graph, int weightAttribute)
+        -> SpanningForest
+    {
+        return run(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute);
+    }
+
+
+    auto Boruvka::run(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute
+        ) -> SpanningForest
+    {
+        if (vertexCount < 0)
+            return {};
+
+        auto edges         = collectEdges(el, vertexCount);
+        auto const weights = loadWeights(el, edges, weightAttribute);
+        if (!weights)
+            return {};
+
+        auto const& w     = *weights;
+        auto const arcs   = el.getArcs();
+        auto const notify = hasSubscribers();
+
+        SpanningForest result;
+        result.treeCount = vertexCount;
+        DisjointSets sets(vertexCount);
+
+        // label[v] -- корень компоненты v на начало раунда.
+        std::vector<int> label(static_cast<size_t>(vertexCount));
+        std::iota(label.begin(), label.end(), 0);
+        std::vector<uint64_t> lightest(static_cast<size_t>(vertexCount), noKey);
+
+        while (!edges.empty() && result.treeCount > 1)
+        {
+            parallelForBlocks(static_cast<int>(edges.size()), grain,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto const arc = edges[i];
+                        auto const key = makeKey(w[arc], arc);
+                        lowerTo(lightest[label[arcs[arc].source]], key);
+                        lowerTo(lightest[label[arcs[arc].target]], key);
+                    }
+                });
+
+            // Лёгкое ребро может быть выбрано обеими компонентами: второй раз unite вернёт false.
+            for (int c = 0; c < vertexCount; ++c)
+            {
+                if (lightest[c] == noKey)
+                    continue;
+
+                auto const arc = static_cast<int>(lightest[c] & 0xFFFF'FFFFu);
+                lightest[c] = noKey;
+
+                auto const [source, target] = arcs[arc];
+                if (!sets.unite(source, target))
+                    continue;
+
+                result.arcs.push_back(arc);
+                result.totalWeight += w[arc];
+                --result.treeCount;
+                if (notify)
+                    broadcast(events::ArcIsTree{ .arc = { source, target } });
+            }
+
+            parallelForBlocks(vertexCount, grain,
+                [&](int, int begin, int end)
+                {
+                    for (int v = begin; v < end; ++v)
+                        label[v] = sets.findRoot(v);
+                });
+
+            edges = parallelFilter(edges,
+                [&](int arc) noexcept
+                {
+                    return label[arcs[arc].source] != label[arcs[arc].target];
+                });
+        }
+
+        return result;
+    }
+
+
+    auto Boruvka::run(Graph const& graph, int weightAttribute)
+        -> SpanningForest
+    {
+        return run(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute);
+    }
+
+}
@@ -0,0 +1,217 @@
+/// @file  algorithm_topological_sort.cpp
+/// @brief Алгоритм Кана (последовательный и по волнам) и самые длинные пути по волнам.
+#include "../include/algorithm_topological_sort.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        [[nodiscard]] auto computeInDegrees(CompressedAdjacency const& graph)
+            -> std::vector<int>
+        {
+            std::vector<int> inDegrees(static_cast<size_t>(graph.getVertexCount()));
+            auto const targets = graph.getAllTargets();
+            parallelForBlocks(static_cast<int>(targets.size()), 1 << 16,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                        std::atomic_ref(inDegrees[targets[i]]).fetch_add(1, std::memory_order_relaxed);
+                });
+
+            return inDegrees;
+        }
+
+
+        [[nodiscard]] auto computeWavefronts(CompressedAdjacency const& graph)
+            -> Wavefronts
+        {
+            auto const vertexCount = graph.getVertexCount();
+            auto inDegrees = computeInDegrees(graph);
+
+            Wavefronts result;
+            auto& vertices = result.vertices;
+            vertices.reserve(static_cast<size_t>(vertexCount));
+            for (int v = 0; v < vertexCount; ++v)
+                if (inDegrees[v] == 0)
+                    vertices.push_back(v);
+
+            result.offsets = { 0, static_cast<int>(vertices.size()) };
+            std::vector<std::vector<int>> nextByWorker(static_cast<size_t>(getWorkerCount()));
+            for (int wave = 0; result.offsets[wave] < result.offsets[wave + 1]; ++wave)
+            {
+                auto const first = result.offsets[wave];
+                parallelForBlocks(result.offsets[wave + 1] - first, 256,
+                    [&](int worker, int begin, int end)
+                    {
+                        auto& next = nextByWorker[worker];
+                        for (int i = first + begin; i < first + end; ++i)
+                        {
+                            for (int const t: graph.getTargets(vertices[i]))
+                                if (std::atomic_ref(inDegrees[t]).fetch_sub(1, std::memory_order_relaxed) == 1)
+                                    next.push_back(t);
+                        }
+                    });
+
+                for (auto& next: nextByWorker)
+                {
+                    vertices.insert(vertices.end(), next.begin(), next.end());
+                    next.clear();
+                }
+
+                std::sort(vertices.begin() + result.offsets[wave + 1], vertices.end());
+                result.offsets.push_back(static_cast<int>(vertices.size()));
+            }
+
+            // Последняя волна всегда пуста.
+            result.offsets.pop_back();
+            if (vertices.size() != static_cast<size_t>(vertexCount))
+                return {};
+            return result;
+        }
+
+    }
+
+
+    auto computeInDegrees(AdjacencyListView const& al)
+        -> std::vector<int>
+    {
+        std::vector<int> inDegrees(static_cast<size_t>(al.getVertexCount()));
+        for (int v = 0; v < al.getVertexCount(); ++v)
+            for (int const t: al.getTargets(v))
+                ++inDegrees[t];
+        return inDegrees;
+    }
+
+
+    auto sortTopologically(AdjacencyListView const& al)
+        -> std::vector<int>
+    {
+        auto const vertexCount = al.getVertexCount();
+        auto inDegrees = computeInDegrees(al);
+
+        // Массив результата служит и очередью: вершины [head, size) ещё не обработаны.
+        std::vector<int> order;
+        order.reserve(static_cast<size_t>(vertexCount));
+        for (int v = 0; v < vertexCount; ++v)
+            if (inDegrees[v] == 0)
+                order.push_back(v);
+
+        for (size_t head = 0; head < order.size(); ++head)
+            for (int const t: al.getTargets(order[head]))
+                if (--inDegrees[t] == 0)
+                    order.push_back(t);
+
+        if (order.size() != static_cast<size_t>(vertexCount))
+            order.clear();
+        return order;
+    }
+
+
+    auto computeWavefronts(AdjacencyListView const& al)
+        -> Wavefronts
+    {
+        return computeWavefronts(CompressedAdjacency::fromAdjacencyList(al));
+    }
+
+
+    auto computeLongestPaths(
+            EdgeListView const& el,
+            int                 vertexCount,
+            int                 weightAttribute
+        ) -> LongestPaths
+    {
+        if (vertexCount < 0)
+            return {};
+
+        auto const csr   = CompressedAdjacency::fromEdgeList(el, vertexCount);
+        auto const waves = computeWavefronts(csr);
+        if (waves.offsets.empty())
+            return {};
+
+        std::span<float const> weights;
+        if (weightAttribute >= 0)
+        {
+            if (weightAttribute >= el.getFloatAttributeCount())
+                return {};
+            weights = el.getFloatAttributes(weightAttribute);
+            if (weights.size() < el.getArcs().size())
+                return {};
+            for (int const arc: csr.getAllArcIndices())
+                if (weights[arc] != weights[arc])
+                    return {};
+        }
+
+        auto const pull = csr.transposed();
+        LongestPaths result;
+        result.distances.assign(static_cast<size_t>(vertexCount), 0.f);
+        result.parents.assign(static_cast<size_t>(vertexCount), -1);
+        result.parentArcs.assign(static_cast<size_t>(vertexCount), -1);
+
+        // Предшественники вершины лежат в более ранних волнах и уже обработаны.
+        for (int wave = 1; wave < waves.getWaveCount(); ++wave)
+        {
+            auto const vertices = waves.getWave(wave);
+            parallelForBlocks(static_cast<int>(vertices.size()), 256,
+                [&](int, int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        auto const v       = vertices[i];
+                        auto const sources = pull.getTargets(v);
+                        auto const arcs    = pull.getArcIndices(v);
+                        auto best = 0.f;
+                        for (size_t k = 0; k < sources.size(); ++k)
+                        {
+                            auto const length = result.distances[sources[k]] + (weights.empty()? 1.f: weights[arcs[k]]);
+                            if (result.parents[v] == -1 || length > best)
+                            {
+                                best = length;
+                                result.parents[v]    = sources[k];
+                                result.parentArcs[v] = arcs[k];
+                            }
+                        }
+
+                        // Отрицательные дуги: путь из одной вершины может оказаться длиннее.
+                        if (best < 0.f)
+                        {
+                            best = 0.f;
+                            result.parents[v]    = -1;
+                            result.parentArcs[v] = -1;
+                        }
+
+                        result.distances[v] = best;
+                    }
+                });
+        }
+
+        auto end = 0;
+        for (int v = 1; v < vertexCount; ++v)
+            if (result.distances[v] > result.distances[end])
+                end = v;
+
+        if (vertexCount > 0)
+        {
+            result.length = result.distances[end];
+            for (int v = end; v != -1; v = result.parents[v])
+                result.criticalPath.push_back(v);
+            std::ranges::reverse(result.criticalPath);
+        }
+
+        return result;
+    }
+
+
+    auto computeLongestPaths(Graph const& graph, int weightAttribute)
+        -> LongestPaths
+    {
+        return computeLongestPaths(graph.getEdgeListView(), graph.getVertexCount(), weightAttribute);
+    }
+
+}
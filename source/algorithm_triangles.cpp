@@ -0,0 +1,345 @@
+/// @file  algorithm_triangles.cpp
+/// @brief Подсчёт треугольников: ориентация рёбер по степеням, пересечение окрестностей
+///        слиянием (CSR) или пословным AND (битовая матрица), параллельно по вершинам.
+#include "../include/algorithm_triangles.hpp"
+#include "../include/aligned_bit_matrix.hpp"
+#include "../include/compressed_adjacency.hpp"
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <numeric>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace gravis24::algorithm
+{
+
+    namespace
+    {
+
+        // Пересечение упорядоченных по возрастанию массивов без повторов;
+        // onMatch вызывается для каждого общего элемента, возвращается их число.
+        template <typename OnMatch>
+        auto intersectSorted(std::span<int const> a, std::span<int const> b, OnMatch onMatch)
+            -> int64_t
+        {
+            int64_t count = 0;
+            size_t  i = 0, j = 0;
+
+#if defined(__AVX2__)
+            // Сравнение блока a со всеми циклическими сдвигами блока b:
+            // 8 сравнений дают маску совпавших элементов a.
+            auto const rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+            while (i + 8 <= a.size() && j + 8 <= b.size())
+            {
+                auto const va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a.data() + i));
+                auto       vb = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b.data() + j));
+                auto       eq = _mm256_cmpeq_epi32(va, vb);
+                for (int r = 1; r < 8; ++r)
+                {
+                    vb = _mm256_permutevar8x32_epi32(vb, rotate);
+                    eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+                }
+
+                auto const mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+                count += std::popcount(mask);
+                for (auto bits = mask; bits != 0; bits &= bits - 1)
+                    onMatch(a[i + std::countr_zero(bits)]);
+
+                auto const lastA = a[i + 7];
+                auto const lastB = b[j + 7];
+                if (lastA <= lastB)
+                    i += 8;
+                if (lastB <= lastA)
+                    j += 8;
+            }
+#endif
+
+            while (i < a.size() && j < b.size())
+            {
+                if (a[i] < b[j])
+                {
+                    ++i;
+                }
+                else if (b[j] < a[i])
+                {
+                    ++j;
+                }
+                else
+                {
+                    onMatch(a[i]);
+                    ++count;
+                    ++i;
+                    ++j;
+                }
+            }
+
+            return count;
+        }
+
+
+        // Ориентированный граф: у каждой вершины остаются соседи большего "ранга"
+        // (степень, затем номер); окрестности по-прежнему упорядочены по номеру.
+        struct OrientedGraph
+        {
+            std::vector<int> degrees;
+            std::vector<int> offsets;
+            std::vector<int> targets;
+
+            [[nodiscard]] auto getTargets(int v) const noexcept
+                -> std::span<int const>
+            {
+                return std::span<int const>(targets)
+                    .subspan(static_cast<size_t>(offsets[v]), static_cast<size_t>(offsets[v + 1] - offsets[v]));
+            }
+        };
+
+
+        [[nodiscard]] auto orientByDegree(AdjacencyListView const& al)
+            -> OrientedGraph
+        {
+            auto const simple      = CompressedAdjacency::fromAdjacencyList(al).symmetrized();
+            auto const vertexCount = simple.getVertexCount();
+
+            OrientedGraph result;
+            result.degrees.resize(static_cast<size_t>(vertexCount));
+            for (int v = 0; v < vertexCount; ++v)
+                result.degrees[v] = simple.getTargetCount(v);
+
+            auto const& degrees = result.degrees;
+            auto const precedes = [&degrees](int u, int v) noexcept
+                {
+                    return degrees[u] < degrees[v] || (degrees[u] == degrees[v] && u < v);
+                };
+
+            result.offsets.resize(static_cast<size_t>(vertexCount) + 1);
+            result.offsets[0] = 0;
+            for (int u = 0; u < vertexCount; ++u)
+            {
+                auto const neighbours = simple.getTargets(u);
+                result.offsets[u + 1] = result.offsets[u] + static_cast<int>(
+                    std::ranges::count_if(neighbours, [&](int v) { return precedes(u, v); }));
+            }
+
+            result.targets.resize(static_cast<size_t>(result.offsets.back()));
+            parallelForBlocks(vertexCount, 1024,
+                [&](int, int begin, int end)
+                {
+                    for (int u = begin; u < end; ++u)
+                        std::ranges::copy_if(simple.getTargets(u),
+                            result.targets.begin() + result.offsets[u],
+                            [&](int v) { return precedes(u, v); });
+                });
+
+            return result;
+        }
+
+
+        // Треугольники (u, v, w) перечисляются по дугам u -> v ориентированного графа.
+        template <bool countPerVertex>
+        auto countOriented(OrientedGraph const& graph, std::vector<int64_t>& triangles)
+            -> int64_t
+        {
+            auto const vertexCount = static_cast<int>(graph.degrees.size());
+            [[maybe_unused]] auto const add = [&triangles](int v, int64_t count) noexcept
+                {
+                    std::atomic_ref(triangles[v]).fetch_add(count, std::memory_order_relaxed);
+                };
+
+            std::vector<int64_t> partial(static_cast<size_t>(getWorkerCount()));
+            parallelForBlocks(vertexCount, 64,
+                [&](int worker, int begin, int end)
+                {
+                    int64_t sum = 0;
+                    for (int u = begin; u < end; ++u)
+                    {
+                        auto const outU = graph.getTargets(u);
+                        int64_t atU = 0;
+                        for (int const v: outU)
+                        {
+                            auto const common = intersectSorted(outU, graph.getTargets(v),
+                                [&](int w)
+                                {
+                                    if constexpr (countPerVertex)
+                                        add(w, 1);
+                                });
+
+                            atU += common;
+                            if constexpr (countPerVertex)
+                                if (common != 0)
+                                    add(v, common);
+                        }
+
+                        if constexpr (countPerVertex)
+                            if (atU != 0)
+                                add(u, atU);
+                        sum += atU;
+                    }
+
+                    partial[worker] += sum;
+                });
+
+            return std::reduce(partial.begin(), partial.end(), int64_t{0});
+        }
+
+
+        // Верхний треугольник симметризованной матрицы (без диагонали): бит (u, v) при u < v.
+        struct UpperBitMatrix
+        {
+            AlignedBitMatrix bits;
+            std::vector<int> degrees;
+        };
+
+
+        [[nodiscard]] auto makeUpperBitMatrix(DenseAdjacencyMatrixView const& am)
+            -> UpperBitMatrix
+        {
+            auto const vertexCount = am.getVertexCount();
+            auto const full        = AlignedBitMatrix::fromAdjacencyMatrix(am);
+
+            UpperBitMatrix result{ AlignedBitMatrix(vertexCount, vertexCount), std::vector<int>(static_cast<size_t>(vertexCount)) };
+            for (int u = 0; u < vertexCount; ++u)
+            {
+                for (int v = u + 1; v < vertexCount; ++v)
+                {
+                    if (full.get(u, v) || full.get(v, u))
+                    {
+                        result.bits.set(u, v);
+                        ++result.degrees[u];
+                        ++result.degrees[v];
+                    }
+                }
+            }
+
+            return result;
+        }
+
+
+        template <bool countPerVertex>
+        auto countUpper(UpperBitMatrix const& upper, std::vector<int64_t>& triangles)
+            -> int64_t
+        {
+            auto const vertexCount = static_cast<int>(upper.degrees.size());
+            auto const rowWords    = upper.bits.getRowWords();
+            [[maybe_unused]] auto const add = [&triangles](int v, int64_t count) noexcept
+                {
+                    std::atomic_ref(triangles[v]).fetch_add(count, std::memory_order_relaxed);
+                };
+
+            std::vector<int64_t> partial(static_cast<size_t>(getWorkerCount()));
+            parallelForBlocks(vertexCount, 16,
+                [&](int worker, int begin, int end)
+                {
+                    int64_t sum = 0;
+                    for (int u = begin; u < end; ++u)
+                    {
+                        auto const rowU = upper.bits.row(u);
+                        int64_t atU = 0;
+                        upper.bits.forEachSetBit(u, [&](int v)
+                            {
+                                // Строка v содержит только биты > v.
+                                auto const rowV = upper.bits.row(v);
+                                int64_t common = 0;
+                                for (size_t w = static_cast<size_t>(v) / AlignedBitMatrix::wordBits; w < rowWords; ++w)
+                                {
+                                    auto const both = rowU[w] & rowV[w];
+                                    common += std::popcount(both);
+                                    if constexpr (countPerVertex)
+                                    {
+                                        for (auto bits = both; bits != 0; bits &= bits - 1)
+                                            add(static_cast<int>(w * AlignedBitMatrix::wordBits) + std::countr_zero(bits), 1);
+                                    }
+                                }
+
+                                atU += common;
+                                if constexpr (countPerVertex)
+                                    if (common != 0)
+                                        add(v, common);
+                            });
+
+                        if constexpr (countPerVertex)
+                            if (atU != 0)
+                                add(u, atU);
+                        sum += atU;
+                    }
+
+                    partial[worker] += sum;
+                });
+
+            return std::reduce(partial.begin(), partial.end(), int64_t{0});
+        }
+
+
+        [[nodiscard]] auto makeCoefficients(
+                std::vector<int64_t>    triangles,
+                std::vector<int> const& degrees,
+                int64_t                 triangleCount
+            ) -> ClusteringCoefficients
+        {
+            ClusteringCoefficients result;
+            auto const vertexCount = degrees.size();
+            result.local.resize(vertexCount);
+
+            double triples = 0., localSum = 0.;
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                auto const d     = static_cast<double>(degrees[v]);
+                auto const pairs = d * (d - 1.) / 2.;
+                triples += pairs;
+                if (degrees[v] >= 2)
+                {
+                    result.local[v] = static_cast<float>(triangles[v] / pairs);
+                    localSum += result.local[v];
+                }
+            }
+
+            result.triangles         = std::move(triangles);
+            result.triangleCount     = triangleCount;
+            result.transitivity      = triples > 0.? static_cast<float>(3. * triangleCount / triples): 0.f;
+            result.averageClustering = vertexCount > 0? static_cast<float>(localSum / vertexCount): 0.f;
+            return result;
+        }
+
+    }
+
+
+    auto countTriangles(AdjacencyListView const& al)
+        -> int64_t
+    {
+        std::vector<int64_t> unused;
+        return countOriented<false>(orientByDegree(al), unused);
+    }
+
+
+    auto countTriangles(DenseAdjacencyMatrixView const& am)
+        -> int64_t
+    {
+        std::vector<int64_t> unused;
+        return countUpper<false>(makeUpperBitMatrix(am), unused);
+    }
+
+
+    auto computeClusteringCoefficients(AdjacencyListView const& al)
+        -> ClusteringCoefficients
+    {
+        auto const graph = orientByDegree(al);
+        std::vector<int64_t> triangles(graph.degrees.size());
+        auto const count = countOriented<true>(graph, triangles);
+        return makeCoefficients(std::move(triangles), graph.degrees, count);
+    }
+
+
+    auto computeClusteringCoefficients(DenseAdjacencyMatrixView const& am)
+        -> ClusteringCoefficients
+    {
+        auto const upper = makeUpperBitMatrix(am);
+        std::vector<int64_t> triangles(upper.degrees.size());
+        auto const count = countUpper<true>(upper, triangles);
+        return makeCoefficients(std::move(triangles), upper.degrees, count);
+    }
+
+}
@@ -0,0 +1,95 @@
+/// @file  attribute_columns.cpp
+#include "../include/attribute_columns.hpp"
+
+#include <algorithm>
+
+namespace gravis24
+{
+
+    namespace
+    {
+
+        template <typename AttrType, typename GetAttributes>
+        bool storeVertexAttributes(
+                EditableAdjacencyList&    al,
+                int                       attributeIndex,
+                int                       attributeCount,
+                std::span<AttrType const> values,
+                GetAttributes             getAttributes
+            ) noexcept
+        {
+            auto const vertexCount = al.getVertexCount();
+            if (static_cast<unsigned>(attributeIndex) >= static_cast<unsigned>(attributeCount)
+             || values.size() != static_cast<size_t>(vertexCount))
+                return false;
+
+            for (int v = 0; v < vertexCount; ++v)
+            {
+                auto const attrs = getAttributes(v);
+                if (static_cast<size_t>(attributeIndex) < attrs.size())
+                    attrs[attributeIndex] = values[v];
+            }
+
+            return true;
+        }
+
+
+        template <typename AttrType>
+        bool storeArcAttributes(
+                std::span<AttrType>       column,
+                std::span<AttrType const> values,
+                size_t                    arcCount
+            ) noexcept
+        {
+            if (values.size() != arcCount || column.size() < arcCount)
+                return false;
+
+            std::ranges::copy(values, column.begin());
+            return true;
+        }
+
+    }
+
+
+    bool storeVertexIntAttributes(
+            EditableAdjacencyList& al,
+            int                    attributeIndex,
+            std::span<int const>   values
+        ) noexcept
+    {
+        return storeVertexAttributes(al, attributeIndex, al.getVertexIntAttributeCount(), values,
+            [&al](int v) noexcept { return al.getVertexIntAttributes(v); });
+    }
+
+
+    bool storeVertexFloatAttributes(
+            EditableAdjacencyList& al,
+            int                    attributeIndex,
+            std::span<float const> values
+        ) noexcept
+    {
+        return storeVertexAttributes(al, attributeIndex, al.getVertexFloatAttributeCount(), values,
+            [&al](int v) noexcept { return al.getVertexFloatAttributes(v); });
+    }
+
+
+    bool storeArcIntAttributes(
+            EditableEdgeList&    el,
+            int                  attributeIndex,
+            std::span<int const> values
+        ) noexcept
+    {
+        return storeArcAttributes(el.getIntAttributes(attributeIndex), values, el.getArcs().size());
+    }
+
+
+    bool storeArcFloatAttributes(
+            EditableEdgeList&      el,
+            int                    attributeIndex,
+            std::span<float const> values
+        ) noexcept
+    {
+        return storeArcAttributes(el.getFloatAttributes(attributeIndex), values, el.getArcs().size());
+    }
+
+}
@@ -0,0 +1,192 @@
+/// @file  compressed_adjacency.cpp
+/// @brief Построение CompressedAdjacency сортировкой подсчётом по начальным вершинам дуг.
+#include "../include/compressed_adjacency.hpp"
+
+#include "../include/parallel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace gravis24
+{
+
+    auto CompressedAdjacency::fromEdgeList(EdgeListView const& el, int vertexCount)
+        -> CompressedAdjacency
+    {
+        CompressedAdjacency result;
+        vertexCount = std::max(vertexCount, 0);
+
+        auto const arcs = el.getArcs();
+        auto const isValid = [vertexCount](Arc arc) noexcept
+            {
+                return static_cast<unsigned>(arc.source) < static_cast<unsigned>(vertexCount)
+                    && static_cast<unsigned>(arc.target) < static_cast<unsigned>(vertexCount);
+            };
+
+        auto& offsets = result._offsets;
+        offsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+        for (auto const arc: arcs)
+            if (isValid(arc))
+                ++offsets[arc.source + 1];
+
+        for (int v = 0; v < vertexCount; ++v)
+            offsets[v + 1] += offsets[v];
+
+        auto const arcCount = static_cast<size_t>(offsets.back());
+        result._targets.resize(arcCount);
+        result._arcIndices.resize(arcCount);
+
+        std::vector<int> position(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            auto const arc = arcs[i];
+            if (!isValid(arc))
+                continue;
+
+            auto const at = position[arc.source]++;
+            result._targets[at]    = arc.target;
+            result._arcIndices[at] = static_cast<int>(i);
+        }
+
+        return result;
+    }
+
+
+    auto CompressedAdjacency::fromAdjacencyList(AdjacencyListView const& al)
+        -> CompressedAdjacency
+    {
+        CompressedAdjacency result;
+        auto const vertexCount = std::max(al.getVertexCount(), 0);
+
+        auto& offsets = result._offsets;
+        offsets.reserve(static_cast<size_t>(vertexCount) + 1);
+        offsets.push_back(0);
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            auto const targets = al.getTargets(v);
+            result._targets.insert(result._targets.end(), targets.begin(), targets.end());
+            offsets.push_back(static_cast<int>(result._targets.size()));
+        }
+
+        result._arcIndices.resize(result._targets.size());
+        for (size_t i = 0; i < result._arcIndices.size(); ++i)
+            result._arcIndices[i] = static_cast<int>(i);
+
+        return result;
+    }
+
+
+    auto CompressedAdjacency::transposed() const
+        -> CompressedAdjacency
+    {
+        CompressedAdjacency result;
+        auto const vertexCount = getVertexCount();
+
+        auto& offsets = result._offsets;
+        offsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+        for (int const target: _targets)
+            ++offsets[target + 1];
+
+        for (int v = 0; v < vertexCount; ++v)
+            offsets[v + 1] += offsets[v];
+
+        result._targets.resize(_targets.size());
+        result._arcIndices.resize(_targets.size());
+
+        std::vector<int> position(offsets.begin(), offsets.end() - 1);
+        for (int source = 0; source < vertexCount; ++source)
+        {
+            for (int i = _offsets[source]; i < _offsets[source + 1]; ++i)
+            {
+                auto const at = position[_targets[i]]++;
+                result._targets[at]    = source;
+                result._arcIndices[at] = _arcIndices[i];
+            }
+        }
+
+        return result;
+    }
+
+
+
+    auto CompressedAdjacency::symmetrized() const
+        -> CompressedAdjacency
+    {
+        auto const vertexCount = getVertexCount();
+
+        // Сначала все рёбра в обе стороны вместе с номерами дуг.
+        std::vector<int> offsets(static_cast<size_t>(vertexCount) + 1, 0);
+        for (int source = 0; source < vertexCount; ++source)
+        {
+            for (int i = _offsets[source]; i < _offsets[source + 1]; ++i)
+            {
+                if (_targets[i] == source)
+                    continue;
+                ++offsets[source + 1];
+                ++offsets[_targets[i] + 1];
+            }
+        }
+
+        for (int v = 0; v < vertexCount; ++v)
+            offsets[v + 1] += offsets[v];
+
+        std::vector<std::pair<int, int>> edges(static_cast<size_t>(offsets.back()));
+        {
+            std::vector<int> position(offsets.begin(), offsets.end() - 1);
+            for (int source = 0; source < vertexCount; ++source)
+            {
+                for (int i = _offsets[source]; i < _offsets[source + 1]; ++i)
+                {
+                    auto const target = _targets[i];
+                    if (target == source)
+                        continue;
+                    edges[position[source]++] = { target, _arcIndices[i] };
+                    edges[position[target]++] = { source, _arcIndices[i] };
+                }
+            }
+        }
+
+        // Упорядочить окрестности и удалить повторы (остаётся наименьший номер дуги).
+        std::vector<int> uniqueCount(static_cast<size_t>(vertexCount));
+        parallelForBlocks(vertexCount, 1024,
+            [&](int, int begin, int end)
+            {
+                for (int v = begin; v < end; ++v)
+                {
+                    auto const first = edges.begin() + offsets[v];
+                    auto const last  = edges.begin() + offsets[v + 1];
+                    std::sort(first, last);
+                    auto const tail = std::unique(first, last,
+                        [](auto const& a, auto const& b) { return a.first == b.first; });
+                    uniqueCount[v] = static_cast<int>(tail - first);
+                }
+            });
+
+        CompressedAdjacency result;
+        result._offsets.resize(static_cast<size_t>(vertexCount) + 1);
+        result._offsets[0] = 0;
+        for (int v = 0; v < vertexCount; ++v)
+            result._offsets[v + 1] = result._offsets[v] + uniqueCount[v];
+
+        auto const edgeCount = static_cast<size_t>(result._offsets.back());
+        result._targets.resize(edgeCount);
+        result._arcIndices.resize(edgeCount);
+        parallelForBlocks(vertexCount, 1024,
+            [&](int, int begin, int end)
+            {
+                for (int v = begin; v < end; ++v)
+                {
+                    auto const from = offsets[v];
+                    auto const to   = result._offsets[v];
+                    for (int k = 0; k < uniqueCount[v]; ++k)
+                    {
+                        result._targets[to + k]    = edges[from + k].first;
+                        result._arcIndices[to + k] = edges[from + k].second;
+                    }
+                }
+            });
+
+        return result;
+    }
+
+}
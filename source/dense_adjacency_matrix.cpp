@@ -3,6 +3,7 @@
 #include "../include/dense_adjacency_matrix.hpp"
 #include <vector>
 #include <algorithm>
+#include <memory_resource>
 
 namespace gravis24
 {
@@ -21,6 +22,12 @@ namespace gravis24
             reshape(vertexCount);
         }
 
+        DenseAdjacencyMatrix(int vertexCount, std::pmr::memory_resource* resource)
+            : _bits(resource)
+        {
+            reshape(vertexCount);
+        }
+
         /////////////////////////////////////////////////////
         // Реализация интерфейса AdjacencyMatrixView
 
@@ -64,8 +71,8 @@ namespace gravis24
         }
 
     private:
-        std::vector<Chunk> _bits;
-        int                _vertexCount {};
+        std::pmr::vector<Chunk> _bits;
+        int                     _vertexCount {};
     };
 
 
@@ -75,4 +82,11 @@ namespace gravis24
         return std::make_unique<DenseAdjacencyMatrix>(vertexCount);
     }
 
+
+    auto newDenseAdjacencyMatrix(int vertexCount, std::pmr::memory_resource* resource)
+        -> std::unique_ptr<EditableDenseAdjacencyMatrix>
+    {
+        return std::make_unique<DenseAdjacencyMatrix>(vertexCount, resource);
+    }
+
 }
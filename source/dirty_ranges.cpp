@@ -0,0 +1,47 @@
+/// @file  dirty_ranges.cpp
+/// @brief Слияние полуинтервалов изменённых индексов.
+#include "../include/dirty_ranges.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace gravis24
+{
+
+    void DirtyRanges::normalize()
+    {
+        if (_isNormalized)
+            return;
+
+        std::ranges::sort(_ranges, {}, &Range::begin);
+        size_t last = 0;
+        for (size_t i = 1; i < _ranges.size(); ++i)
+        {
+            if (_ranges[i].begin <= _ranges[last].end)
+                _ranges[last].end = std::max(_ranges[last].end, _ranges[i].end);
+            else
+                _ranges[++last] = _ranges[i];
+        }
+
+        _ranges.resize(last + 1);
+        _isNormalized = true;
+    }
+
+
+    auto DirtyRanges::getIndexCount() const noexcept
+        -> int
+    {
+        int count = 0;
+        for (auto const& range: _ranges)
+            count += range.end - range.begin;
+        return count;
+    }
+
+
+    bool DirtyRanges::contains(int index) const noexcept
+    {
+        auto const after = std::ranges::upper_bound(_ranges, index, {}, &Range::begin);
+        return after != _ranges.begin() && index < std::prev(after)->end;
+    }
+
+}
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <memory_resource>
 
 namespace gravis24
 {
@@ -136,9 +137,11 @@ namespace gravis24
         explicit EdgeListUnsortedVector(
                 int arcsCount, 
                 int intAttrsCount   = 0, 
-                int floatAttrsCount = 0)
-            : _intAttrs(intAttrsCount)
-            , _floatAttrs(floatAttrsCount)
+                int floatAttrsCount = 0,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _arcs(resource)
+            , _intAttrs(intAttrsCount, resource)
+            , _floatAttrs(floatAttrsCount, resource)
         {
             _arcs.reserve(arcsCount);
             for (auto& attrs: _intAttrs)
@@ -148,9 +151,10 @@ namespace gravis24
         }
 
     private:
-        std::vector<Arc>                _arcs;
-        std::vector<std::vector<int>>   _intAttrs;
-        std::vector<std::vector<float>> _floatAttrs;
+        // Вложенные массивы атрибутов берут память у того же источника.
+        std::pmr::vector<Arc>                     _arcs;
+        std::pmr::vector<std::pmr::vector<int>>   _intAttrs;
+        std::pmr::vector<std::pmr::vector<float>> _floatAttrs;
 
         void attributesResize()
         {
@@ -195,4 +199,16 @@ namespace gravis24
             preallocArcsCount, intAttrsCount, floatAttrsCount);
     }
 
+
+    auto newEdgeListUnsortedVector(
+            int                        preallocArcsCount,
+            int                        intAttrsCount,
+            int                        floatAttrsCount,
+            std::pmr::memory_resource* resource
+        ) -> std::unique_ptr<EditableEdgeList>
+    {
+        return std::make_unique<EdgeListUnsortedVector>(
+            preallocArcsCount, intAttrsCount, floatAttrsCount, resource);
+    }
+
 }
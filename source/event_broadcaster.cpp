@@ -0,0 +1,39 @@
+/// @file  event_broadcaster.cpp
+/// @brief Реализация EventBroadcaster на основе вектора указателей на подписчиков.
+#include "../include/event_broadcaster.hpp"
+
+#include <algorithm>
+
+namespace gravis24
+{
+
+    void EventBroadcaster::subscribe(EventListener& listener)
+    {
+        if (isSubscribed(listener))
+            return;
+
+        _listeners.push_back(&listener);
+        listener.subscribed(*this);
+    }
+
+
+    void EventBroadcaster::unsubscribe(EventListener& listener)
+    {
+        if (std::erase(_listeners, &listener) != 0)
+            listener.unsubscribed(*this);
+    }
+
+
+    bool EventBroadcaster::isSubscribed(EventListener& listener) const noexcept
+    {
+        return std::ranges::find(_listeners, &listener) != _listeners.end();
+    }
+
+
+    void EventBroadcaster::broadcast(Event const& event)
+    {
+        for (auto listener: _listeners)
+            listener->post(event, *this);
+    }
+
+}
@@ -1,8 +1,14 @@
 ﻿/// @file graph.cpp
 #include "../include/graph.hpp"
+#include "../include/parallel.hpp"
 
 #include <type_traits>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include <doctest/doctest.h>
@@ -227,7 +233,9 @@ namespace gravis24
         )
     {
         auto sizes = obtainArcDataSizes(from);
-        al.resize(vertexCount, sizes.intAttrCount, sizes.floatAttrCount);
+        al.resize(vertexCount);
+        al.resizeArcIntAttributes(sizes.intAttrCount);
+        al.resizeArcFloatAttributes(sizes.floatAttrCount);
         visitAllArcs(from, 
             [&](Arc arc,
                 std::span<int const>   srcIntAttrs,
@@ -247,18 +255,151 @@ namespace gravis24
     }
 
 
+    // Срез: представления, бывшие у графа, разделяются с ним; недостающие строятся
+    // из них под std::call_once. Исходные представления (_source...) не меняются после создания.
+    class DefaultGraphSnapshot final
+        : public GraphSnapshot
+    {
+    public:
+        DefaultGraphSnapshot(
+                uint64_t                                        version,
+                int                                             vertexCount,
+                int                                             arcCount,
+                std::shared_ptr<EdgeListView const>             el,
+                std::shared_ptr<DenseAdjacencyMatrixView const> am,
+                std::shared_ptr<AdjacencyListView const>        al,
+                std::shared_ptr<VertexPositionArrays const>     positions
+            ) noexcept
+            : _version(version)
+            , _vertexCount(vertexCount)
+            , _arcCount(arcCount)
+            , _sourceEl(std::move(el))
+            , _sourceAm(std::move(am))
+            , _sourceAl(std::move(al))
+            , _positions(std::move(positions))
+        {
+            // Пусто.
+        }
+
+        [[nodiscard]] auto getVersion() const noexcept
+            -> uint64_t override
+        {
+            return _version;
+        }
+
+        [[nodiscard]] auto getVertexCount() const noexcept
+            -> int override
+        {
+            return _vertexCount;
+        }
+
+        [[nodiscard]] auto getArcCount() const noexcept
+            -> int override
+        {
+            return _arcCount;
+        }
+
+        [[nodiscard]] auto getEdgeListView() const
+            -> EdgeListView const& override
+        {
+            if (_sourceEl)
+                return *_sourceEl;
+
+            std::call_once(_elIsBuilt, [this]
+                {
+                    auto el = newEdgeListUnsortedVector();
+                    if (_sourceAl)
+                        convertGraphRepresentation(*_sourceAl, *el, _vertexCount);
+                    else if (_sourceAm)
+                        convertGraphRepresentation(*_sourceAm, *el, _vertexCount);
+                    _el = std::move(el);
+                });
+            return *_el;
+        }
+
+        [[nodiscard]] auto getAdjacencyMatrixView() const
+            -> DenseAdjacencyMatrixView const& override
+        {
+            if (_sourceAm)
+                return *_sourceAm;
+
+            std::call_once(_amIsBuilt, [this]
+                {
+                    auto am = newDenseAdjacencyMatrix(_vertexCount);
+                    if (_sourceEl)
+                        convertGraphRepresentation(*_sourceEl, *am, _vertexCount);
+                    else if (_sourceAl)
+                        convertGraphRepresentation(*_sourceAl, *am, _vertexCount);
+                    _am = std::move(am);
+                });
+            return *_am;
+        }
+
+        [[nodiscard]] auto getAdjacencyListView() const
+            -> AdjacencyListView const& override
+        {
+            if (_sourceAl)
+                return *_sourceAl;
+
+            std::call_once(_alIsBuilt, [this]
+                {
+                    auto al = newAdjacencyListVector(_vertexCount);
+                    if (_sourceEl)
+                        convertGraphRepresentation(*_sourceEl, *al, _vertexCount);
+                    else if (_sourceAm)
+                        convertGraphRepresentation(*_sourceAm, *al, _vertexCount);
+                    _al = std::move(al);
+                });
+            return *_al;
+        }
+
+        [[nodiscard]] auto getVertexPositionArrays() const noexcept
+            -> VertexPositionArrays const& override
+        {
+            return *_positions;
+        }
+
+    private:
+        uint64_t _version;
+        int      _vertexCount;
+        int      _arcCount;
+
+        std::shared_ptr<EdgeListView const>             _sourceEl;
+        std::shared_ptr<DenseAdjacencyMatrixView const> _sourceAm;
+        std::shared_ptr<AdjacencyListView const>        _sourceAl;
+        std::shared_ptr<VertexPositionArrays const>     _positions;
+
+        mutable std::once_flag                                _elIsBuilt;
+        mutable std::once_flag                                _amIsBuilt;
+        mutable std::once_flag                                _alIsBuilt;
+        mutable std::unique_ptr<EditableEdgeList>             _el;
+        mutable std::unique_ptr<EditableDenseAdjacencyMatrix> _am;
+        mutable std::unique_ptr<EditableAdjacencyList>        _al;
+    };
+
+
     class DefaultGraphImplementation final
         : public Graph
     {
     public:
-        DefaultGraphImplementation() noexcept = default;
+        DefaultGraphImplementation() = default;
 
         explicit DefaultGraphImplementation(int vertexCount)
-            : _vertexCount(vertexCount)
+            : _positions(std::make_shared<VertexPositionArrays>(vertexCount))
+            , _vertexCount(vertexCount)
         {
             // Пусто.
         }
 
+        DefaultGraphImplementation(std::unique_ptr<EditableEdgeList> el, int vertexCount)
+            : _positions(std::make_shared<VertexPositionArrays>(vertexCount))
+            , _vertexCount(vertexCount)
+            , _arcCount(static_cast<int>(el->getArcs().size()))
+            , _el(std::move(el))
+        {
+            _publishViews();
+        }
+
         [[nodiscard]] auto getVertexCount() const noexcept
             -> int override
         {
@@ -273,94 +414,149 @@ namespace gravis24
 
         [[nodiscard]] bool hasEdgeListView() const noexcept override
         {
-            return _el != nullptr;
+            return _publishedEl.load(std::memory_order_acquire) != nullptr;
         }
 
         void removeEdgeList() noexcept override
         {
             _el.reset();
+            _publishViews();
         }
 
         [[nodiscard]] auto getEdgeListView() const
             -> EdgeListView const& override
         {
+            if (auto const* el = _publishedEl.load(std::memory_order_acquire))
+                return *el;
+
+            std::lock_guard const lock(_elMutex);
             if (!_el)
             {
-                _el = newEdgeListUnsortedVector();
-                if (_al)
-                    convertGraphRepresentation(*_al, *_el, getVertexCount());
-                else if (_am)
-                    convertGraphRepresentation(*_am, *_el, getVertexCount());
+                auto el = newEdgeListUnsortedVector();
+                if (auto const* al = _publishedAl.load(std::memory_order_acquire))
+                    convertGraphRepresentation(*al, *el, getVertexCount());
+                else if (auto const* am = _publishedAm.load(std::memory_order_acquire))
+                    convertGraphRepresentation(*am, *el, getVertexCount());
+                _el = std::move(el);
             }
 
+            _publishedEl.store(_el.get(), std::memory_order_release);
             return *_el;
         }
 
 
         [[nodiscard]] bool hasAdjacencyMatrixView() const noexcept override
         {
-            return _am != nullptr;
+            return _publishedAm.load(std::memory_order_acquire) != nullptr;
         }
 
         void removeAdjacencyMatrix() noexcept override
         {
             _am.reset();
+            _publishViews();
         }
 
         [[nodiscard]] auto getAdjacencyMatrixView() const
             -> DenseAdjacencyMatrixView const& override
         {
+            if (auto const* am = _publishedAm.load(std::memory_order_acquire))
+                return *am;
+
+            std::lock_guard const lock(_amMutex);
             if (!_am)
             {
                 auto const vertexCount = getVertexCount();
-                _am = newDenseAdjacencyMatrix(vertexCount);
-                if (_el)
-                    convertGraphRepresentation(*_el, *_am, vertexCount);
-                else if (_al)
-                    convertGraphRepresentation(*_al, *_am, vertexCount);
+                auto am = newDenseAdjacencyMatrix(vertexCount);
+                if (auto const* el = _publishedEl.load(std::memory_order_acquire))
+                    convertGraphRepresentation(*el, *am, vertexCount);
+                else if (auto const* al = _publishedAl.load(std::memory_order_acquire))
+                    convertGraphRepresentation(*al, *am, vertexCount);
+                _am = std::move(am);
             }
 
+            _publishedAm.store(_am.get(), std::memory_order_release);
             return *_am;
         }
 
 
         [[nodiscard]] bool hasAdjacencyListView() const noexcept override
         {
-            return _al != nullptr;
+            return _publishedAl.load(std::memory_order_acquire) != nullptr;
         }
 
         void removeAdjacencyList() noexcept override
         {
             _al.reset();
+            _publishViews();
         }
 
         [[nodiscard]] auto getAdjacencyListView() const
             -> AdjacencyListView const& override
         {
+            if (auto const* al = _publishedAl.load(std::memory_order_acquire))
+                return *al;
+
+            std::lock_guard const lock(_alMutex);
             if (!_al)
             {
                 auto const vertexCount = getVertexCount();
-                _al = newAdjacencyListVector(vertexCount);
-                if (_el)
-                    convertGraphRepresentation(*_el, *_al, vertexCount);
-                else if (_am)
-                    convertGraphRepresentation(*_am, *_al, vertexCount);
+                auto al = newAdjacencyListVector(vertexCount);
+                if (auto const* el = _publishedEl.load(std::memory_order_acquire))
+                    convertGraphRepresentation(*el, *al, vertexCount);
+                else if (auto const* am = _publishedAm.load(std::memory_order_acquire))
+                    convertGraphRepresentation(*am, *al, vertexCount);
+                _al = std::move(al);
             }
 
+            _publishedAl.store(_al.get(), std::memory_order_release);
             return *_al;
         }
 
+        auto prefetchViews(GraphViews views) const
+            -> std::future<void> override
+        {
+            return std::async(std::launch::async, [this, views]
+                {
+                    // Разные представления строятся параллельно.
+                    std::array<GraphViews, 3> requested;
+                    int count = 0;
+                    for (auto const view: { GraphViews::EdgeList, GraphViews::AdjacencyMatrix, GraphViews::AdjacencyList })
+                        if ((views & view) != GraphViews::None)
+                            requested[count++] = view;
+
+                    parallelForBlocks(count, 1,
+                        [this, &requested](int, int begin, int end)
+                        {
+                            for (int i = begin; i < end; ++i)
+                            {
+                                if (requested[i] == GraphViews::EdgeList)
+                                    (void)getEdgeListView();
+                                else if (requested[i] == GraphViews::AdjacencyMatrix)
+                                    (void)getAdjacencyMatrixView();
+                                else
+                                    (void)getAdjacencyListView();
+                            }
+                        });
+                });
+        }
+
 
         /// @brief  Добавить заданное число вершин (по умолчанию одну).
         /// @return индекс последней добавленной вершины
         int addVertex(int addedCount) override
         {
             CHECK(addedCount >= 0);
+            _detachViews();
+            _detachPositions();
+            ++_version;
             _vertexCount += addedCount;
+            _positions->resize(_vertexCount);
+            _xyzIsCurrent = false;
             if (_al)
                 _al->resize(_vertexCount);
             if (_am)
                 _am.reset();
+            _publishViews();
 
             return _vertexCount - 1;
         }
@@ -374,6 +570,7 @@ namespace gravis24
             if (auto max_vertex = std::max(source, target); max_vertex >= _vertexCount)
                 addVertex(max_vertex - _vertexCount + 1);
 
+            _detachViews();
             if (_am)
             {
                 auto row = _am->getRow(source);
@@ -387,6 +584,7 @@ namespace gravis24
                     _al->connect(source, target);
 
                 ++_arcCount;
+                ++_version;
                 return true;
             }
 
@@ -399,14 +597,19 @@ namespace gravis24
                     _el->connect(source, target);
 
                 ++_arcCount;
+                ++_version;
                 return true;
             }
 
             if (!_el)
+            {
                 _el = newEdgeListUnsortedVector();
+                _publishViews();
+            }
 
             _el->connect(source, target);
             ++_arcCount;
+            ++_version;
             return true;
         }
 
@@ -419,6 +622,7 @@ namespace gravis24
             if (!_arcVerticesAreValid(source, target))
                 return false;
 
+            _detachViews();
             if (_am)
             {
                 auto row = _am->getRow(source);
@@ -432,6 +636,7 @@ namespace gravis24
                     _el->disconnect(source, target);
                 
                 --_arcCount;
+                ++_version;
                 return true;
             }
 
@@ -443,12 +648,14 @@ namespace gravis24
                     _el->disconnect(source, target);
                 
                 --_arcCount;
+                ++_version;
                 return true;
             }
 
             if (_el && _el->disconnect(source, target))
             {
                 --_arcCount;
+                ++_version;
                 return true;
             }
 
@@ -460,42 +667,192 @@ namespace gravis24
             if (!_arcVerticesAreValid(source, target))
                 return false;
 
-            if (_am)
-                return _am->getRow(source).getBit(target);
-            if (_al)
-                return _al->areConnected(source, target);
-            if (_el)
-                return _el->areConnected(source, target);
+            if (auto const* am = _publishedAm.load(std::memory_order_acquire))
+                return am->getRow(source).getBit(target);
+            if (auto const* al = _publishedAl.load(std::memory_order_acquire))
+                return al->areConnected(source, target);
+            if (auto const* el = _publishedEl.load(std::memory_order_acquire))
+                return el->areConnected(source, target);
 
             return false;
         }
 
         friend class ChangeableVertexPositions;
+        friend class ChangeableVertexPositionArrays;
 
         [[nodiscard]] auto getVertexPositions() const noexcept
             -> std::span<XYZ const> override
         {
+            _materializeXYZ();
             return _xyz;
         }
 
         [[nodiscard]] auto getVertexPositions() noexcept
             -> ChangeableVertexPositions override
         {
+            _detachPositions();
+            _materializeXYZ();
+            _xyzIsChanging = true;
             return { *this, _xyz };
         }
 
+        [[nodiscard]] auto getVertexPositionArrays() const noexcept
+            -> VertexPositionArrays const& override
+        {
+            return *_positions;
+        }
+
+        [[nodiscard]] auto getVertexPositionArrays() noexcept
+            -> ChangeableVertexPositionArrays override
+        {
+            _detachPositions();
+            return { *this, *_positions };
+        }
+
+        void subscribe(VertexPositionListener& listener) override
+        {
+            if (std::ranges::find(_positionListeners, &listener) == _positionListeners.end())
+                _positionListeners.push_back(&listener);
+        }
+
+        void unsubscribe(VertexPositionListener& listener) noexcept override
+        {
+            std::erase(_positionListeners, &listener);
+        }
+
+        [[nodiscard]] auto getVersion() const noexcept
+            -> uint64_t override
+        {
+            return _version;
+        }
+
+        [[nodiscard]] auto snapshot() const
+            -> std::shared_ptr<GraphSnapshot const> override
+        {
+            std::scoped_lock const lock(_elMutex, _amMutex, _alMutex);
+            return std::make_shared<DefaultGraphSnapshot>(
+                _version, _vertexCount, _arcCount, _el, _am, _al, _positions);
+        }
+
         // Отдельная обработка атрибутов вершин и рёбер
 
 
     private:
-        std::vector<XYZ> _xyz;
+        // Основное хранилище координат -- структура массивов (может разделяться со срезами);
+        // массив структур _xyz строится по запросу и после изменения копируется обратно.
+        std::shared_ptr<VertexPositionArrays> _positions = std::make_shared<VertexPositionArrays>();
+        mutable std::vector<XYZ>  _xyz;
+        mutable std::atomic<bool> _xyzIsCurrent  = false;
+        mutable std::mutex        _xyzMutex;
+        bool                      _xyzIsChanging = false;
+
+        std::vector<VertexPositionListener*> _positionListeners;
         
-        int _vertexCount = 0;
-        int _arcCount    = 0;
+        int      _vertexCount = 0;
+        int      _arcCount    = 0;
+        uint64_t _version     = 0;
+
+        // Представления могут разделяться со срезами (snapshot).
+        // Константные методы строят недостающее представление под его мьютексом и публикуют
+        // указатель (release); читатели берут опубликованный указатель без блокировки (acquire).
+        // Изменяющие методы вызываются без параллельных читателей и публикуют указатели сами.
+        mutable std::shared_ptr<EditableEdgeList>             _el;
+        mutable std::shared_ptr<EditableDenseAdjacencyMatrix> _am;
+        mutable std::shared_ptr<EditableAdjacencyList>        _al;
+
+        mutable std::atomic<EditableEdgeList*>             _publishedEl {};
+        mutable std::atomic<EditableDenseAdjacencyMatrix*> _publishedAm {};
+        mutable std::atomic<EditableAdjacencyList*>        _publishedAl {};
+        mutable std::mutex                                 _elMutex;
+        mutable std::mutex                                 _amMutex;
+        mutable std::mutex                                 _alMutex;
+
+        // Копируются только изменённые полуинтервалы: из _xyz в _positions после записи
+        // через getVertexPositions, обратно -- после записи в массивы, если _xyz уже построен.
+        void onVertexPositionsChange(DirtyRanges const& changed) noexcept override
+        {
+            if (changed.empty())
+            {
+                _xyzIsChanging = false;
+                return;
+            }
 
-        mutable std::unique_ptr<EditableEdgeList>             _el;
-        mutable std::unique_ptr<EditableDenseAdjacencyMatrix> _am;
-        mutable std::unique_ptr<EditableAdjacencyList>        _al;
+            for (auto const [begin, end]: changed.getRanges())
+            {
+                if (_xyzIsChanging)
+                {
+                    for (int v = begin; v < end; ++v)
+                        _positions->set(v, _xyz[v]);
+                }
+                else if (_xyzIsCurrent)
+                {
+                    for (int v = begin; v < end; ++v)
+                        _xyz[v] = _positions->get(v);
+                }
+            }
+
+            _xyzIsChanging = false;
+            ++_version;
+            for (auto* listener: _positionListeners)
+                listener->onVertexPositionsChange(*this, changed);
+        }
+
+        void _materializeXYZ() const noexcept
+        {
+            if (_xyzIsCurrent.load(std::memory_order_acquire))
+                return;
+
+            std::lock_guard const lock(_xyzMutex);
+            if (_xyzIsCurrent.load(std::memory_order_relaxed))
+                return;
+
+            // Вызывается из noexcept-функций: при нехватке памяти завершение программы,
+            // как и у прочих контейнеров графа.
+            _xyz.resize(static_cast<size_t>(_positions->size()));
+            _positions->copyTo(_xyz);
+            _xyzIsCurrent.store(true, std::memory_order_release);
+        }
+
+        // Копирование при записи: представление, которое разделяет срез, копируется перед изменением.
+        // Срезы только уменьшают счётчик ссылок (в других потоках), поэтому use_count() == 1 окончательно.
+        void _detachViews()
+        {
+            if (_el && _el.use_count() > 1)
+            {
+                std::shared_ptr<EditableEdgeList> el = newEdgeListUnsortedVector();
+                convertGraphRepresentation(*_el, *el);
+                _el = std::move(el);
+            }
+
+            if (_am && _am.use_count() > 1)
+            {
+                std::shared_ptr<EditableDenseAdjacencyMatrix> am = newDenseAdjacencyMatrix(_vertexCount);
+                convertGraphRepresentation(*_am, *am, _vertexCount);
+                _am = std::move(am);
+            }
+
+            if (_al && _al.use_count() > 1)
+            {
+                std::shared_ptr<EditableAdjacencyList> al = newAdjacencyListVector(_vertexCount);
+                convertGraphRepresentation(*_al, *al, _vertexCount);
+                _al = std::move(al);
+            }
+
+            _publishViews();
+        }
+
+        void _publishViews() noexcept
+        {
+            _publishedEl.store(_el.get(), std::memory_order_release);
+            _publishedAm.store(_am.get(), std::memory_order_release);
+            _publishedAl.store(_al.get(), std::memory_order_release);
+        }
+
+        void _detachPositions()
+        {
+            if (_positions.use_count() > 1)
+                _positions = std::make_shared<VertexPositionArrays>(*_positions);
+        }
 
         [[nodiscard]] bool _vertexIsValid(int v) const noexcept
         {
@@ -515,4 +872,14 @@ namespace gravis24
         return std::make_unique<DefaultGraphImplementation>(vertexCount);
     }
 
+
+    auto newGraph(std::unique_ptr<EditableEdgeList> el, int vertexCount)
+        -> std::unique_ptr<Graph>
+    {
+        if (!el)
+            return newGraph(vertexCount);
+
+        return std::make_unique<DefaultGraphImplementation>(std::move(el), vertexCount);
+    }
+
 }
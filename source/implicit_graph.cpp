@@ -0,0 +1,510 @@
+/// @file  implicit_graph.cpp
+/// @brief Реализация неявных графов (ImplicitGraphView), окрестности которых вычисляются на лету.
+#include "../include/implicit_graph.hpp"
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <bit>
+
+namespace gravis24
+{
+
+    // Элементы реализации.
+    namespace
+    {
+
+        // Буфер потока для getTargets: span, возвращаемый getTargets,
+        // действителен до следующего вызова в том же потоке.
+        [[nodiscard]] auto threadTargetsBuffer(int size)
+            -> std::span<int>
+        {
+            thread_local std::vector<int> buffer;
+            if (buffer.size() < static_cast<size_t>(size))
+                buffer.resize(static_cast<size_t>(size));
+            return buffer;
+        }
+
+
+        class ArcWithoutAttributes
+            : public AdjacencyListView::ConstArcHandle
+        {
+        public:
+            explicit ArcWithoutAttributes(int target) noexcept
+                : _target{ target }
+            {
+                // Пусто.
+            }
+
+            auto target() const noexcept
+                -> int override
+            {
+                return _target;
+            }
+
+            auto getIntAttributes() const noexcept
+                -> std::span<int const> override
+            {
+                return {};
+            }
+
+            auto getFloatAttributes() const noexcept
+                -> std::span<float const> override
+            {
+                return {};
+            }
+
+        private:
+            int _target {-1};
+        };
+
+
+        // Общая часть всех неявных графов: нет атрибутов, getTargets через буфер потока.
+        class ImplicitGraphBase
+            : public ImplicitGraphView
+        {
+        public:
+            explicit ImplicitGraphBase(int vertexCount) noexcept
+                : _vertexCount{ vertexCount }
+            {
+                // Пусто.
+            }
+
+            [[nodiscard]] auto getVertexCount() const noexcept
+                -> int override
+            {
+                return _vertexCount;
+            }
+
+            [[nodiscard]] auto getTargets(int vertex) const noexcept
+                -> std::span<int const> override
+            {
+                if (!isValidVertex(vertex))
+                    return {};
+
+                auto const buffer = threadTargetsBuffer(getMaxTargetCount());
+                auto const count  = copyTargets(vertex, buffer);
+                return buffer.first(static_cast<size_t>(count));
+            }
+
+            [[nodiscard]] auto getVertexIntAttributeCount() const noexcept
+                -> int override
+            {
+                return 0;
+            }
+
+            [[nodiscard]] auto getVertexFloatAttributeCount() const noexcept
+                -> int override
+            {
+                return 0;
+            }
+
+            [[nodiscard]] auto getArcIntAttributeCount() const noexcept
+                -> int override
+            {
+                return 0;
+            }
+
+            [[nodiscard]] auto getArcFloatAttributeCount() const noexcept
+                -> int override
+            {
+                return 0;
+            }
+
+            [[nodiscard]] auto getVertexIntAttributes(int) const noexcept
+                -> std::span<int const> override
+            {
+                return {};
+            }
+
+            [[nodiscard]] auto getVertexFloatAttributes(int) const noexcept
+                -> std::span<float const> override
+            {
+                return {};
+            }
+
+            [[nodiscard]] auto getArc(int source, int target) const noexcept
+                -> std::unique_ptr<ConstArcHandle> override
+            {
+                if (!areConnected(source, target))
+                    return {};
+                return std::make_unique<ArcWithoutAttributes>(target);
+            }
+
+        protected:
+            [[nodiscard]] bool isValidVertex(int vertex) const noexcept
+            {
+                return static_cast<unsigned>(vertex) < static_cast<unsigned>(_vertexCount);
+            }
+
+        private:
+            int _vertexCount {};
+        };
+
+
+        // Решётка (до трёх измерений) с замыканием или без.
+        // Лишние измерения имеют размер 1 и не порождают дуг.
+        class LatticeGraph final
+            : public ImplicitGraphBase
+        {
+        public:
+            LatticeGraph(std::array<int, 3> extents, bool wrap) noexcept
+                : ImplicitGraphBase{ extents[0] * extents[1] * extents[2] }
+                , _extents{ extents }
+                , _strides{ 1, extents[0], extents[0] * extents[1] }
+                , _wrap{ wrap }
+            {
+                for (int const n: _extents)
+                    _maxTargetCount += std::min(2, n - 1);
+            }
+
+            [[nodiscard]] auto getMaxTargetCount() const noexcept
+                -> int override
+            {
+                return _maxTargetCount;
+            }
+
+            [[nodiscard]] auto getTargetCount(int vertex) const noexcept
+                -> int override
+            {
+                if (!isValidVertex(vertex))
+                    return 0;
+
+                auto const coords = _coordinates(vertex);
+                int count = 0;
+                for (int d = 0; d < 3; ++d)
+                {
+                    auto const n = _extents[d];
+                    if (_wrap || n <= 2)
+                        count += std::min(2, n - 1);
+                    else
+                        count += 2 - (coords[d] == 0) - (coords[d] == n - 1);
+                }
+
+                return count;
+            }
+
+            [[nodiscard]] auto copyTargets(int vertex, std::span<int> buffer) const noexcept
+                -> int override
+            {
+                if (!isValidVertex(vertex) || buffer.size() < static_cast<size_t>(_maxTargetCount))
+                    return 0;
+
+                auto const coords = _coordinates(vertex);
+                int count = 0;
+                for (int d = 0; d < 3; ++d)
+                {
+                    auto const n      = _extents[d];
+                    auto const c      = coords[d];
+                    auto const stride = _strides[d];
+                    auto const jump   = (n - 1) * stride;
+                    if (n == 1)
+                        continue;
+
+                    if (_wrap && n > 2)
+                    {
+                        buffer[count++] = c > 0?     vertex - stride: vertex + jump;
+                        buffer[count++] = c < n - 1? vertex + stride: vertex - jump;
+                    }
+                    else
+                    {
+                        // Без замыкания, либо n == 2 (оба соседа по тору совпадают).
+                        if (c > 0)
+                            buffer[count++] = vertex - stride;
+                        if (c < n - 1)
+                            buffer[count++] = vertex + stride;
+                    }
+                }
+
+                return count;
+            }
+
+            [[nodiscard]] bool areConnected(int source, int target) const noexcept override
+            {
+                if (!isValidVertex(source) || !isValidVertex(target))
+                    return false;
+
+                auto const s = _coordinates(source);
+                auto const t = _coordinates(target);
+                int differentAxes = 0;
+                bool adjacent     = false;
+                for (int d = 0; d < 3; ++d)
+                {
+                    if (s[d] == t[d])
+                        continue;
+
+                    ++differentAxes;
+                    auto const delta = std::abs(s[d] - t[d]);
+                    adjacent = delta == 1 || (_wrap && delta == _extents[d] - 1);
+                }
+
+                return differentAxes == 1 && adjacent;
+            }
+
+        private:
+            std::array<int, 3> _extents {};
+            std::array<int, 3> _strides {};
+            bool               _wrap           {};
+            int                _maxTargetCount {};
+
+            [[nodiscard]] auto _coordinates(int vertex) const noexcept
+                -> std::array<int, 3>
+            {
+                auto const x    = vertex % _extents[0];
+                auto const rest = vertex / _extents[0];
+                return { x, rest % _extents[1], rest / _extents[1] };
+            }
+        };
+
+
+        // Окрестность v -- отрезок [v + 1, v + n - 1] последовательности 0..n-1, 0..n-1.
+        class CompleteGraph final
+            : public ImplicitGraphBase
+        {
+        public:
+            explicit CompleteGraph(int vertexCount)
+                : ImplicitGraphBase{ vertexCount }
+                , _window(2 * static_cast<size_t>(vertexCount))
+            {
+                auto const half = _window.begin() + vertexCount;
+                std::iota(_window.begin(), half, 0);
+                std::iota(half, _window.end(), 0);
+            }
+
+            [[nodiscard]] auto getMaxTargetCount() const noexcept
+                -> int override
+            {
+                return std::max(getVertexCount() - 1, 0);
+            }
+
+            [[nodiscard]] auto getTargetCount(int vertex) const noexcept
+                -> int override
+            {
+                return isValidVertex(vertex)? getVertexCount() - 1: 0;
+            }
+
+            [[nodiscard]] auto getTargets(int vertex) const noexcept
+                -> std::span<int const> override
+            {
+                if (!isValidVertex(vertex))
+                    return {};
+                return std::span<int const>(_window)
+                    .subspan(static_cast<size_t>(vertex) + 1, static_cast<size_t>(getVertexCount() - 1));
+            }
+
+            [[nodiscard]] auto copyTargets(int vertex, std::span<int> buffer) const noexcept
+                -> int override
+            {
+                if (!isValidVertex(vertex) || buffer.size() < static_cast<size_t>(getMaxTargetCount()))
+                    return 0;
+
+                std::ranges::copy(getTargets(vertex), buffer.begin());
+                return getVertexCount() - 1;
+            }
+
+            [[nodiscard]] bool areConnected(int source, int target) const noexcept override
+            {
+                return isValidVertex(source) && isValidVertex(target) && source != target;
+            }
+
+        private:
+            std::vector<int> _window;
+        };
+
+
+        class HypercubeGraph final
+            : public ImplicitGraphBase
+        {
+        public:
+            explicit HypercubeGraph(int dimension) noexcept
+                : ImplicitGraphBase{ 1 << dimension }
+                , _dimension{ dimension }
+            {
+                // Пусто.
+            }
+
+            [[nodiscard]] auto getMaxTargetCount() const noexcept
+                -> int override
+            {
+                return _dimension;
+            }
+
+            [[nodiscard]] auto getTargetCount(int vertex) const noexcept
+                -> int override
+            {
+                return isValidVertex(vertex)? _dimension: 0;
+            }
+
+            [[nodiscard]] auto copyTargets(int vertex, std::span<int> buffer) const noexcept
+                -> int override
+            {
+                if (!isValidVertex(vertex) || buffer.size() < static_cast<size_t>(_dimension))
+                    return 0;
+
+                for (int bit = 0; bit < _dimension; ++bit)
+                    buffer[bit] = vertex ^ (1 << bit);
+                return _dimension;
+            }
+
+            [[nodiscard]] bool areConnected(int source, int target) const noexcept override
+            {
+                return isValidVertex(source) && isValidVertex(target)
+                    && std::popcount(static_cast<unsigned>(source ^ target)) == 1;
+            }
+
+        private:
+            int _dimension {};
+        };
+
+
+        class CirculantGraph final
+            : public ImplicitGraphBase
+        {
+        public:
+            CirculantGraph(int vertexCount, std::span<int const> offsets)
+                : ImplicitGraphBase{ vertexCount }
+            {
+                for (int const offset: offsets)
+                {
+                    // В int64_t: offset % n + n переполняет int при n > INT_MAX / 2.
+                    auto const n     = int64_t{vertexCount};
+                    auto const shift = static_cast<int>((offset % n + n) % n);
+                    if (shift == 0)
+                        continue;
+
+                    _shifts.push_back(shift);
+                    _shifts.push_back(vertexCount - shift);
+                }
+
+                std::ranges::sort(_shifts);
+                auto const [first, last] = std::ranges::unique(_shifts);
+                _shifts.erase(first, last);
+            }
+
+            [[nodiscard]] auto getMaxTargetCount() const noexcept
+                -> int override
+            {
+                return static_cast<int>(_shifts.size());
+            }
+
+            [[nodiscard]] auto getTargetCount(int vertex) const noexcept
+                -> int override
+            {
+                return isValidVertex(vertex)? getMaxTargetCount(): 0;
+            }
+
+            [[nodiscard]] auto copyTargets(int vertex, std::span<int> buffer) const noexcept
+                -> int override
+            {
+                if (!isValidVertex(vertex) || buffer.size() < _shifts.size())
+                    return 0;
+
+                auto const n = getVertexCount();
+                int count = 0;
+                for (int const shift: _shifts)
+                    buffer[count++] = vertex < n - shift? vertex + shift: vertex - (n - shift);
+                return count;
+            }
+
+            [[nodiscard]] bool areConnected(int source, int target) const noexcept override
+            {
+                if (!isValidVertex(source) || !isValidVertex(target))
+                    return false;
+
+                auto const delta = target >= source?
+                    target - source: getVertexCount() - (source - target);
+                return std::ranges::binary_search(_shifts, delta);
+            }
+
+        private:
+            std::vector<int> _shifts;
+        };
+
+
+        // Проверяет, что произведение размеров положительно и помещается в int.
+        [[nodiscard]] bool areValidExtents(std::array<int, 3> extents) noexcept
+        {
+            int64_t product = 1;
+            for (int const n: extents)
+            {
+                if (n <= 0)
+                    return false;
+                product *= n;
+                if (product > INT_MAX)
+                    return false;
+            }
+
+            return true;
+        }
+
+
+        [[nodiscard]] auto newLatticeGraph(std::array<int, 3> extents, bool wrap)
+            -> std::unique_ptr<ImplicitGraphView>
+        {
+            if (!areValidExtents(extents))
+                return {};
+            return std::make_unique<LatticeGraph>(extents, wrap);
+        }
+
+    }
+
+
+    auto newGrid2DGraph(int width, int height)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        return newLatticeGraph({ width, height, 1 }, false);
+    }
+
+
+    auto newTorus2DGraph(int width, int height)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        return newLatticeGraph({ width, height, 1 }, true);
+    }
+
+
+    auto newGrid3DGraph(int width, int height, int depth)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        return newLatticeGraph({ width, height, depth }, false);
+    }
+
+
+    auto newTorus3DGraph(int width, int height, int depth)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        return newLatticeGraph({ width, height, depth }, true);
+    }
+
+
+    auto newCompleteGraph(int vertexCount)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        if (vertexCount < 0 || vertexCount > INT_MAX / 2)
+            return {};
+        return std::make_unique<CompleteGraph>(vertexCount);
+    }
+
+
+    auto newHypercubeGraph(int dimension)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        if (dimension < 0 || dimension > 30)
+            return {};
+        return std::make_unique<HypercubeGraph>(dimension);
+    }
+
+
+    auto newCirculantGraph(int vertexCount, std::span<int const> offsets)
+        -> std::unique_ptr<ImplicitGraphView>
+    {
+        if (vertexCount <= 0)
+            return {};
+        return std::make_unique<CirculantGraph>(vertexCount, offsets);
+    }
+
+}
@@ -0,0 +1,150 @@
+/// @file  memory_resources.cpp
+/// @brief Монотонная арена и источник памяти на больших страницах.
+#include "../include/memory_resources.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace gravis24
+{
+
+    // Заголовок блока арены; данные идут сразу за ним.
+    struct MonotonicArena::Block
+    {
+        Block* next;
+        size_t size; // вместе с заголовком
+    };
+
+
+    MonotonicArena::MonotonicArena(size_t initialBlockSize, std::pmr::memory_resource* upstream) noexcept
+        : _upstream(upstream)
+        , _nextBlockSize(std::max(initialBlockSize, sizeof(Block) + alignof(std::max_align_t)))
+    {
+        // Пусто.
+    }
+
+
+    MonotonicArena::~MonotonicArena()
+    {
+        release();
+    }
+
+
+    void MonotonicArena::release() noexcept
+    {
+        while (_blocks)
+        {
+            auto* const next = _blocks->next;
+            _upstream->deallocate(_blocks, _blocks->size, alignof(std::max_align_t));
+            _blocks = next;
+        }
+
+        _current        = nullptr;
+        _end            = nullptr;
+        _allocatedBytes = 0;
+        _reservedBytes  = 0;
+    }
+
+
+    auto MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+        -> void*
+    {
+        auto const align = [alignment](std::byte* p) noexcept
+            {
+                auto const address = reinterpret_cast<uintptr_t>(p);
+                return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(uintptr_t{alignment} - 1));
+            };
+
+        auto* result = _current? align(_current): nullptr;
+        if (!result || result > _end || static_cast<size_t>(_end - result) < bytes)
+        {
+            // Новый блок: не меньше запроса с запасом на выравнивание, размеры растут вдвое.
+            auto const required = sizeof(Block) + bytes + alignment;
+            auto const size = std::max(_nextBlockSize, required);
+            auto* const block = static_cast<Block*>(_upstream->allocate(size, alignof(std::max_align_t)));
+            block->next = _blocks;
+            block->size = size;
+            _blocks         = block;
+            _reservedBytes += size;
+            _nextBlockSize  = size * 2;
+
+            _current = reinterpret_cast<std::byte*>(block + 1);
+            _end     = reinterpret_cast<std::byte*>(block) + size;
+            result   = align(_current);
+        }
+
+        _allocatedBytes += static_cast<size_t>(result - _current) + bytes;
+        _current = result + bytes;
+        return result;
+    }
+
+
+    void MonotonicArena::do_deallocate(void*, size_t, size_t) noexcept
+    {
+        // Пусто: память возвращается только release.
+    }
+
+
+    namespace
+    {
+
+        [[nodiscard]] constexpr auto roundToHugePages(size_t bytes) noexcept
+            -> size_t
+        {
+            constexpr auto page = HugePageResource::hugePageSize;
+            return (bytes + page - 1) / page * page;
+        }
+
+    }
+
+
+    auto HugePageResource::do_allocate(size_t bytes, size_t alignment)
+        -> void*
+    {
+#if defined(__linux__)
+        if (bytes >= _threshold && alignment <= hugePageSize)
+        {
+            // Лишние 2 МБ отображаются, чтобы выровнять начало, и сразу возвращаются.
+            auto const size   = roundToHugePages(bytes);
+            auto const mapped = size + hugePageSize;
+            auto* const raw = static_cast<std::byte*>(
+                mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+            if (raw == MAP_FAILED)
+                throw std::bad_alloc();
+
+            auto const address = reinterpret_cast<uintptr_t>(raw);
+            auto* const result = reinterpret_cast<std::byte*>((address + hugePageSize - 1) & ~(uintptr_t{hugePageSize} - 1));
+            auto const head = static_cast<size_t>(result - raw);
+            if (head != 0)
+                munmap(raw, head);
+            if (auto const tail = mapped - head - size; tail != 0)
+                munmap(result + size, tail);
+
+#if defined(MADV_HUGEPAGE)
+            madvise(result, size, MADV_HUGEPAGE);
+#endif
+            return result;
+        }
+#endif
+        return _upstream->allocate(bytes, alignment);
+    }
+
+
+    void HugePageResource::do_deallocate(void* pointer, size_t bytes, size_t alignment) noexcept
+    {
+#if defined(__linux__)
+        if (bytes >= _threshold && alignment <= hugePageSize)
+        {
+            munmap(pointer, roundToHugePages(bytes));
+            return;
+        }
+#endif
+        _upstream->deallocate(pointer, bytes, alignment);
+    }
+
+}
@@ -0,0 +1,258 @@
+/// @file  spatial_index.cpp
+/// @brief Пространственный индекс вершин и дуг: построение, обновление и запросы.
+#include "../include/spatial_index.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace gravis24
+{
+
+    namespace
+    {
+
+        [[nodiscard]] auto getPointBox(XYZ const& p) noexcept
+            -> Box
+        {
+            return { p, p };
+        }
+
+
+        // Квадрат расстояния от точки p до отрезка [a, b].
+        [[nodiscard]] auto getSegmentDistance2(XYZ const& p, XYZ const& a, XYZ const& b) noexcept
+            -> float
+        {
+            auto const abx = b.x - a.x, aby = b.y - a.y, abz = b.z - a.z;
+            auto const apx = p.x - a.x, apy = p.y - a.y, apz = p.z - a.z;
+            auto const length2 = abx * abx + aby * aby + abz * abz;
+            auto t = 0.f;
+            if (length2 > 0.f)
+                t = std::clamp((apx * abx + apy * aby + apz * abz) / length2, 0.f, 1.f);
+
+            auto const dx = apx - t * abx, dy = apy - t * aby, dz = apz - t * abz;
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+    }
+
+
+    void SpatialIndex::build(VertexPositionArrays const& positions)
+    {
+        _vertices.build(positions.size(),
+            [&positions](int vertex) noexcept
+            {
+                return getPointBox(positions.get(vertex));
+            });
+        _arcEnds.clear();
+        _buildArcs();
+    }
+
+
+    void SpatialIndex::build(VertexPositionArrays const& positions, EdgeListView const& el)
+    {
+        _vertices.build(positions.size(),
+            [&positions](int vertex) noexcept
+            {
+                return getPointBox(positions.get(vertex));
+            });
+        auto const arcs = el.getArcs();
+        _arcEnds.assign(arcs.begin(), arcs.end());
+        _buildArcs();
+    }
+
+
+    void SpatialIndex::build(Graph const& graph, bool withArcs)
+    {
+        if (withArcs && graph.getArcCount() > 0)
+            build(graph.getVertexPositionArrays(), graph.getEdgeListView());
+        else
+            build(graph.getVertexPositionArrays());
+    }
+
+
+    void SpatialIndex::refit(VertexPositionArrays const& positions, DirtyRanges const& changed)
+    {
+        if (positions.size() != _vertices.getCount())
+        {
+            _vertices.build(positions.size(),
+                [&positions](int vertex) noexcept
+                {
+                    return getPointBox(positions.get(vertex));
+                });
+            _buildArcs();
+            return;
+        }
+
+        std::vector<int> vertices;
+        vertices.reserve(static_cast<size_t>(std::min(changed.getIndexCount(), _vertices.getCount())));
+        for (auto const& range: changed.getRanges())
+        {
+            // Вершины вне [0, getCount()) не индексируются.
+            auto const end = std::min(range.end, _vertices.getCount());
+            for (int vertex = std::max(range.begin, 0); vertex < end; ++vertex)
+                vertices.push_back(vertex);
+        }
+        if (vertices.empty())
+            return;
+
+        _vertices.refit(vertices,
+            [&positions](int vertex) noexcept
+            {
+                return getPointBox(positions.get(vertex));
+            });
+
+        if (_arcEnds.empty())
+            return;
+
+        std::vector<int> arcs;
+        for (int const vertex: vertices)
+        {
+            for (int i = _incidenceOffsets[vertex]; i < _incidenceOffsets[vertex + 1]; ++i)
+                arcs.push_back(_incidentArcs[i]);
+        }
+
+        std::ranges::sort(arcs);
+        arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+        _arcs.refit(arcs,
+            [this](int arc) noexcept
+            {
+                return _getArcBox(arc);
+            });
+    }
+
+
+    void SpatialIndex::onVertexPositionsChange(Graph const& graph, DirtyRanges const& changed)
+    {
+        refit(graph.getVertexPositionArrays(), changed);
+    }
+
+
+    auto SpatialIndex::findNearestVertex(XYZ const& point, float maxDistance) const
+        -> int
+    {
+        return _vertices.findNearest(point,
+            [&point](int, Box const& box) noexcept
+            {
+                return getDistance2(point, box);
+            }, maxDistance * maxDistance);
+    }
+
+
+    auto SpatialIndex::findNearestArc(XYZ const& point, float maxDistance) const
+        -> int
+    {
+        return _arcs.findNearest(point,
+            [this, &point](int arc, Box const& box) noexcept
+            {
+                if (box.low.x > box.high.x)
+                    return std::numeric_limits<float>::infinity();
+
+                auto const [source, target] = _arcEnds[arc];
+                return getSegmentDistance2(point, _getPosition(source), _getPosition(target));
+            }, maxDistance * maxDistance);
+    }
+
+
+    auto SpatialIndex::findVerticesInBox(Box const& box) const
+        -> std::vector<int>
+    {
+        std::vector<int> result;
+        _vertices.traverse(
+            [&box](Box const& node) noexcept
+            {
+                return intersect(box, node);
+            },
+            [&result](int vertex, Box const&)
+            {
+                result.push_back(vertex);
+            });
+        return result;
+    }
+
+
+    auto SpatialIndex::findVerticesInSphere(XYZ const& center, float radius) const
+        -> std::vector<int>
+    {
+        std::vector<int> result;
+        auto const radius2 = radius * radius;
+        _vertices.traverse(
+            [&center, radius2](Box const& node) noexcept
+            {
+                return getDistance2(center, node) <= radius2;
+            },
+            [&result](int vertex, Box const&)
+            {
+                result.push_back(vertex);
+            });
+        return result;
+    }
+
+
+    auto SpatialIndex::_getArcBox(int arc) const noexcept
+        -> Box
+    {
+        auto const [source, target] = _arcEnds[arc];
+        auto const vertexCount = _vertices.getCount();
+        if (source < 0 || source >= vertexCount || target < 0 || target >= vertexCount)
+            return getEmptyBox();
+
+        return unite(getPointBox(_getPosition(source)), getPointBox(_getPosition(target)));
+    }
+
+
+    void SpatialIndex::_buildArcs()
+    {
+        auto const vertexCount = _vertices.getCount();
+        auto const arcCount    = static_cast<int>(_arcEnds.size());
+
+        // Дуги с концами вне графа (после уменьшения числа вершин) не находятся запросами.
+        _incidenceOffsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+        auto const isValid = [vertexCount](int vertex) noexcept
+            {
+                return 0 <= vertex && vertex < vertexCount;
+            };
+        for (auto const& [source, target]: _arcEnds)
+        {
+            if (!isValid(source) || !isValid(target))
+                continue;
+
+            ++_incidenceOffsets[source + 1];
+            if (target != source)
+                ++_incidenceOffsets[target + 1];
+        }
+
+        for (int v = 0; v < vertexCount; ++v)
+            _incidenceOffsets[v + 1] += _incidenceOffsets[v];
+
+        _incidentArcs.resize(static_cast<size_t>(_incidenceOffsets[vertexCount]));
+        std::vector<int> fill(_incidenceOffsets.begin(), _incidenceOffsets.end() - 1);
+        for (int arc = 0; arc < arcCount; ++arc)
+        {
+            auto const [source, target] = _arcEnds[arc];
+            if (!isValid(source) || !isValid(target))
+                continue;
+
+            _incidentArcs[fill[source]++] = arc;
+            if (target != source)
+                _incidentArcs[fill[target]++] = arc;
+        }
+
+        _arcs.build(arcCount,
+            [this](int arc) noexcept
+            {
+                return _getArcBox(arc);
+            });
+    }
+
+
+    void BoxHierarchy::_uniteLeaf(int leaf) noexcept
+    {
+        auto const begin = leaf * leafSize;
+        auto const end   = std::min(begin + leafSize, getCount());
+        auto box = getEmptyBox();
+        for (int slot = begin; slot < end; ++slot)
+            box = unite(box, _itemBoxes[slot]);
+        _nodes[_firstLeaf + leaf] = box;
+    }
+
+}
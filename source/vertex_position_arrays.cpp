@@ -0,0 +1,86 @@
+/// @file  vertex_position_arrays.cpp
+/// @brief Копирование между массивом структур и структурой массивов,
+///        ограничивающий параллелепипед (min/max на AVX по выровненным массивам).
+#include "../include/vertex_position_arrays.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace gravis24
+{
+
+    namespace
+    {
+
+        // Наименьшее и наибольшее значения массива (не пустого).
+        void getRange(std::span<float const> values, float& low, float& high) noexcept
+        {
+            size_t i = 0;
+            low = high = values[0];
+#if defined(__AVX__)
+            if (values.size() >= 8)
+            {
+                // Начало массива выровнено (VertexPositionArrays::alignment).
+                auto lows  = _mm256_load_ps(values.data());
+                auto highs = lows;
+                for (i = 8; i + 8 <= values.size(); i += 8)
+                {
+                    auto const v = _mm256_load_ps(values.data() + i);
+                    lows  = _mm256_min_ps(lows, v);
+                    highs = _mm256_max_ps(highs, v);
+                }
+
+                alignas(32) float lowLanes[8], highLanes[8];
+                _mm256_store_ps(lowLanes, lows);
+                _mm256_store_ps(highLanes, highs);
+                low  = *std::min_element(lowLanes, lowLanes + 8);
+                high = *std::max_element(highLanes, highLanes + 8);
+            }
+#endif
+            for (; i < values.size(); ++i)
+            {
+                low  = std::min(low, values[i]);
+                high = std::max(high, values[i]);
+            }
+        }
+
+    }
+
+
+    void VertexPositionArrays::copyTo(std::span<XYZ> positions) const noexcept
+    {
+        auto const count = std::min(positions.size(), _x.size());
+        for (size_t i = 0; i < count; ++i)
+            positions[i] = { _x[i], _y[i], _z[i] };
+    }
+
+
+    void VertexPositionArrays::copyFrom(std::span<XYZ const> positions) noexcept
+    {
+        auto const count = std::min(positions.size(), _x.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            _x[i] = positions[i].x;
+            _y[i] = positions[i].y;
+            _z[i] = positions[i].z;
+        }
+    }
+
+
+    auto VertexPositionArrays::getBounds() const noexcept
+        -> Box
+    {
+        Box box {};
+        if (empty())
+            return box;
+
+        getRange(_x, box.low.x, box.high.x);
+        getRange(_y, box.low.y, box.high.y);
+        getRange(_z, box.low.z, box.high.z);
+        return box;
+    }
+
+}